@@ -0,0 +1,57 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__CONVERSIONS__LEVER_ARM_REGISTRY_HPP_
+#define ROMEA_LOCALISATION_UTILS__CONVERSIONS__LEVER_ARM_REGISTRY_HPP_
+
+// std
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// eigen
+#include "Eigen/Core"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Lever arms of sensors mounted on the vehicle, keyed by the frame_id of their
+// messages. Lookups read an immutable snapshot, a calibration update publishes a
+// new snapshot atomically so that a concurrent lookup sees either the old or
+// the new lever arm of a sensor, never a mix of both. A lookup hashes the
+// frame_id, there is one lookup per message.
+class LeverArmRegistry
+{
+public:
+  LeverArmRegistry();
+
+  void set(const std::string & frame_id, const Eigen::Vector3d & lever_arm);
+
+  // returns false, leaving lever arm unchanged, if frame is unknown
+  bool find(const std::string & frame_id, Eigen::Vector3d & lever_arm) const;
+
+  size_t size() const;
+
+private:
+  using Table = std::unordered_map<std::string, Eigen::Vector3d>;
+
+  std::shared_ptr<const Table> table_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__CONVERSIONS__LEVER_ARM_REGISTRY_HPP_
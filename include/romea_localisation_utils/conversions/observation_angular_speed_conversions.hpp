@@ -39,6 +39,11 @@ void to_ros_msg(
   const core::ObservationAngularSpeed & observation,
   romea_localisation_msgs::msg::ObservationAngularSpeedStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationAngularSpeed & observation,
+  romea_localisation_msgs::msg::ObservationAngularSpeedStamped & msg);
+
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationAngularSpeedStamped & msg,
   core::ObservationAngularSpeed & observation);
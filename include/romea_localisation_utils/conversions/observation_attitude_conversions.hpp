@@ -38,6 +38,11 @@ void to_ros_msg(
   const core::ObservationAttitude & observation,
   romea_localisation_msgs::msg::ObservationAttitudeStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationAttitude & observation,
+  romea_localisation_msgs::msg::ObservationAttitudeStamped & msg);
+
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationAttitudeStamped & msg,
   core::ObservationAttitude & observation);
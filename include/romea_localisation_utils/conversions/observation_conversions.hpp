@@ -15,6 +15,10 @@
 #ifndef ROMEA_LOCALISATION_UTILS__CONVERSIONS__OBSERVATION_CONVERSIONS_HPP_
 #define ROMEA_LOCALISATION_UTILS__CONVERSIONS__OBSERVATION_CONVERSIONS_HPP_
 
+// ros
+#include "rclcpp/loaned_message.hpp"
+
+// romea
 #include "romea_localisation_utils/conversions/observation_angular_speed_conversions.hpp"
 #include "romea_localisation_utils/conversions/observation_attitude_conversions.hpp"
 #include "romea_localisation_utils/conversions/observation_course_conversions.hpp"
@@ -24,12 +28,20 @@
 #include "romea_localisation_utils/conversions/observation_position_conversions.hpp"
 #include "romea_localisation_utils/conversions/observation_range_conversions.hpp"
 #include "romea_localisation_utils/conversions/observation_twist_conversions.hpp"
+#include "romea_localisation_utils/conversions/stamp_conversions.hpp"
 
 namespace romea
 {
 namespace ros2
 {
 
+// fills a middleware loaned payload in place, see LocalisationLoanedPublisher
+template<typename DataType, typename MessageType>
+void to_ros_msg(const DataType & data, rclcpp::LoanedMessage<MessageType> & msg)
+{
+  to_ros_msg(data, msg.get());
+}
+
 template<typename ObservationType, typename MessageType>
 ObservationType extract_obs(const MessageType & msg)
 {
@@ -38,6 +38,11 @@ void to_ros_msg(
   const core::ObservationCourse & observation,
   romea_localisation_msgs::msg::ObservationCourseStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationCourse & observation,
+  romea_localisation_msgs::msg::ObservationCourseStamped & msg);
+
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationCourseStamped & msg,
   core::ObservationCourse & observation);
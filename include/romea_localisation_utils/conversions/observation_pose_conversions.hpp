@@ -22,6 +22,7 @@
 #include "romea_common_utils/conversions/pose2d_conversions.hpp"
 #include "romea_localisation_msgs/msg/observation_pose2_d_stamped.hpp"
 #include "romea_core_localisation/ObservationPose.hpp"
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
 
 
 namespace romea
@@ -39,6 +40,11 @@ void to_ros_msg(
   const core::Pose2D & position,
   romea_localisation_msgs::msg::ObservationPose2DStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::Pose2D & position,
+  romea_localisation_msgs::msg::ObservationPose2DStamped & msg);
+
 void to_ros_msg(
   const core::ObservationPose & observation,
   romea_localisation_msgs::msg::ObservationPose2D & msg);
@@ -49,8 +55,19 @@ void to_ros_msg(
   const core::ObservationPose & observation,
   romea_localisation_msgs::msg::ObservationPose2DStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationPose & observation,
+  romea_localisation_msgs::msg::ObservationPose2DStamped & msg);
+
+void extract_obs(
+  const romea_localisation_msgs::msg::ObservationPose2DStamped & msg,
+  core::ObservationPose & observation);
+
+// lever arm is taken from registry when message frame is registered
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationPose2DStamped & msg,
+  const LeverArmRegistry & lever_arms,
   core::ObservationPose & observation);
 
 }  // namespace ros2
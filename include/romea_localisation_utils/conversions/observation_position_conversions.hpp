@@ -22,6 +22,7 @@
 #include "romea_common_utils/conversions/position2d_conversions.hpp"
 #include "romea_localisation_msgs/msg/observation_position2_d_stamped.hpp"
 #include "romea_core_localisation/ObservationPosition.hpp"
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
 
 namespace romea
 {
@@ -38,6 +39,11 @@ void to_ros_msg(
   const core::Position2D & position,
   romea_localisation_msgs::msg::ObservationPosition2DStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::Position2D & position,
+  romea_localisation_msgs::msg::ObservationPosition2DStamped & msg);
+
 
 void to_ros_msg(
   const core::ObservationPosition & observation,
@@ -49,8 +55,19 @@ void to_ros_msg(
   const core::ObservationPosition & observation,
   romea_localisation_msgs::msg::ObservationPosition2DStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationPosition & observation,
+  romea_localisation_msgs::msg::ObservationPosition2DStamped & msg);
+
+void extract_obs(
+  const romea_localisation_msgs::msg::ObservationPosition2DStamped & msg,
+  core::ObservationPosition & observation);
+
+// lever arm is taken from registry when message frame is registered
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationPosition2DStamped & msg,
+  const LeverArmRegistry & lever_arms,
   core::ObservationPosition & observation);
 
 }  // namespace ros2
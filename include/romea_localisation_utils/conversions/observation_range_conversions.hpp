@@ -22,6 +22,7 @@
 #include "romea_core_localisation/ObservationRange.hpp"
 #include "romea_common_utils/conversions/time_conversions.hpp"
 #include "romea_localisation_msgs/msg/observation_range_stamped.hpp"
+#include "romea_localisation_utils/conversions/range_anchor_table.hpp"
 
 namespace romea
 {
@@ -38,10 +39,23 @@ void to_ros_msg(
   const core::ObservationRange & observation,
   romea_localisation_msgs::msg::ObservationRangeStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationRange & observation,
+  romea_localisation_msgs::msg::ObservationRangeStamped & msg);
+
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationRangeStamped & msg,
   core::ObservationRange & observation);
 
+// responder antenna position is looked up in anchor table using header frame_id
+// as anchor id, responder position carried by message is ignored. Returns false,
+// leaving observation untouched, when anchor id is unknown.
+bool extract_obs(
+  const romea_localisation_msgs::msg::ObservationRangeStamped & msg,
+  const RangeAnchorTable & anchors,
+  core::ObservationRange & observation);
+
 }  // namespace ros2
 }  // namespace romea
 
@@ -22,6 +22,7 @@
 #include "romea_common_utils/conversions/twist2d_conversions.hpp"
 #include "romea_localisation_msgs/msg/observation_twist2_d_stamped.hpp"
 #include "romea_core_localisation/ObservationTwist.hpp"
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
 
 namespace romea
 {
@@ -38,6 +39,11 @@ void to_ros_msg(
   const core::Twist2D & twist,
   romea_localisation_msgs::msg::ObservationTwist2DStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::Twist2D & twist,
+  romea_localisation_msgs::msg::ObservationTwist2DStamped & msg);
+
 void to_ros_msg(
   const core::ObservationTwist & observation,
   romea_localisation_msgs::msg::ObservationTwist2D & msg);
@@ -48,8 +54,19 @@ void to_ros_msg(
   const core::ObservationTwist & observation,
   romea_localisation_msgs::msg::ObservationTwist2DStamped & msg);
 
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationTwist & observation,
+  romea_localisation_msgs::msg::ObservationTwist2DStamped & msg);
+
+void extract_obs(
+  const romea_localisation_msgs::msg::ObservationTwist2DStamped & msg,
+  core::ObservationTwist & observation);
+
+// lever arm is taken from registry when message frame is registered
 void extract_obs(
   const romea_localisation_msgs::msg::ObservationTwist2DStamped & msg,
+  const LeverArmRegistry & lever_arms,
   core::ObservationTwist & observation);
 
 }  // namespace ros2
@@ -0,0 +1,63 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__CONVERSIONS__RANGE_ANCHOR_TABLE_HPP_
+#define ROMEA_LOCALISATION_UTILS__CONVERSIONS__RANGE_ANCHOR_TABLE_HPP_
+
+// std
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// eigen
+#include "Eigen/Core"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Positions of fixed ranging anchors (responder antennas) in world frame, keyed
+// by anchor id. Positions are stored contiguously, find() resolves an id to an
+// index with one hash lookup and get_position(index) is then a plain access.
+class RangeAnchorTable
+{
+public:
+  static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+public:
+  RangeAnchorTable();
+
+  void add(const std::string & anchor_id, const Eigen::Vector3d & position);
+
+  size_t size() const;
+
+  size_t find(const std::string & anchor_id) const;
+
+  const Eigen::Vector3d & get_position(const size_t & index) const;
+
+  const Eigen::Vector3d & get_position(const std::string & anchor_id) const;
+
+  // one anchor per line: "anchor_id x y z", lines starting with # are ignored
+  static RangeAnchorTable load(const std::string & filename);
+
+private:
+  std::vector<Eigen::Vector3d> positions_;
+  std::unordered_map<std::string, size_t> indexes_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__CONVERSIONS__RANGE_ANCHOR_TABLE_HPP_
@@ -0,0 +1,50 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__CONVERSIONS__STAMP_CONVERSIONS_HPP_
+#define ROMEA_LOCALISATION_UTILS__CONVERSIONS__STAMP_CONVERSIONS_HPP_
+
+// std
+#include <cstdint>
+
+// ros
+#include "builtin_interfaces/msg/time.hpp"
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Stamp in nanoseconds computed with integer arithmetic only, neither an
+// rclcpp::Time nor floating point seconds are built, so two stamps compare
+// exactly as they were written by the sender.
+inline int64_t to_nanoseconds(const builtin_interfaces::msg::Time & stamp)
+{
+  return static_cast<int64_t>(stamp.sec) * 1000000000LL + static_cast<int64_t>(stamp.nanosec);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+core::Duration extract_stamp(const Msg & msg)
+{
+  return core::Duration(to_nanoseconds(msg.header.stamp));
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__CONVERSIONS__STAMP_CONVERSIONS_HPP_
@@ -0,0 +1,144 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_CHECKPOINT_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_CHECKPOINT_HPP_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// eigen
+#include "Eigen/Core"
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+struct LocalisationCheckpointData
+{
+  core::Duration stamp;
+  uint32_t fsm_state;
+  // state and covariance of a kalman filter, or particles and weights of a
+  // particle filter
+  Eigen::MatrixXd state;
+  Eigen::MatrixXd covariance;
+};
+
+// Keeps the latest filter state in a memory mapped file so that a restarted node
+// can resume from it instead of waiting for absolute fixes. Two slots are used
+// alternately, a slot is written entirely before being marked as the latest
+// one, so that a crash during a save leaves the previous checkpoint intact.
+// Slots are checksummed to detect pages lost on power failure.
+class LocalisationCheckpoint
+{
+public:
+  // capacity is the maximal number of values (state + covariance) of a checkpoint
+  LocalisationCheckpoint(const std::string & filename, const size_t & capacity);
+
+  ~LocalisationCheckpoint();
+
+  LocalisationCheckpoint(const LocalisationCheckpoint &) = delete;
+  LocalisationCheckpoint & operator=(const LocalisationCheckpoint &) = delete;
+
+  template<typename State, typename Covariance>
+  void save(
+    const core::Duration & stamp,
+    const uint32_t & fsm_state,
+    const Eigen::MatrixBase<State> & state,
+    const Eigen::MatrixBase<Covariance> & covariance);
+
+  // returns false if there is no valid checkpoint or if it is older than maximal age
+  bool restore(
+    const core::Duration & now,
+    const core::Duration & maximal_age,
+    LocalisationCheckpointData & data) const;
+
+  size_t get_capacity() const;
+
+  uint64_t get_number_of_saves() const;
+
+private:
+  struct Header;
+  struct Slot;
+
+  Slot & begin_save_(
+    const core::Duration & stamp,
+    const uint32_t & fsm_state,
+    const Eigen::Index & state_rows,
+    const Eigen::Index & state_cols,
+    const Eigen::Index & covariance_rows,
+    const Eigen::Index & covariance_cols);
+
+  double * get_values_(Slot & slot);
+
+  const double * get_values_(const Slot & slot) const;
+
+  void end_save_(Slot & slot);
+
+  Slot & get_slot_(const size_t & index) const;
+
+  const Slot * find_latest_slot_() const;
+
+  uint64_t compute_checksum_(const Slot & slot) const;
+
+  void initialize_();
+
+private:
+  std::string filename_;
+  size_t capacity_;
+  size_t slot_size_;
+  int file_descriptor_;
+  size_t mapping_size_;
+  void * mapping_;
+  Header * header_;
+  size_t latest_slot_index_;
+  uint64_t number_of_saves_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename State, typename Covariance>
+void LocalisationCheckpoint::save(
+  const core::Duration & stamp,
+  const uint32_t & fsm_state,
+  const Eigen::MatrixBase<State> & state,
+  const Eigen::MatrixBase<Covariance> & covariance)
+{
+  Slot & slot = begin_save_(
+    stamp, fsm_state, state.rows(), state.cols(), covariance.rows(), covariance.cols());
+
+  double * values = get_values_(slot);
+  Eigen::Map<Eigen::MatrixXd>(values, state.rows(), state.cols()) = state;
+  Eigen::Map<Eigen::MatrixXd>(values + state.size(), covariance.rows(), covariance.cols()) =
+    covariance;
+
+  end_save_(slot);
+}
+
+std::shared_ptr<LocalisationCheckpoint> make_checkpoint(
+  std::shared_ptr<rclcpp::Node> node,
+  const size_t & capacity);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_CHECKPOINT_HPP_
@@ -0,0 +1,96 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_CHECKPOINT_SAVER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_CHECKPOINT_SAVER_HPP_
+
+// std
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// eigen
+#include "Eigen/Core"
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_core_localisation/LocalisationFSMState.hpp"
+#include "romea_localisation_utils/filter/localisation_checkpoint.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Saves filter state into a checkpoint at a fixed period from a wall timer.
+// Snapshot function reads filter state into the given buffers, which are kept
+// between saves, and returns false when there is nothing worth saving (e.g.
+// filter still initialising). It is called from the timer callback group, so it
+// must read filter state consistently with filter updates.
+class LocalisationCheckpointSaver
+{
+public:
+  using SnapshotFunction = std::function<bool(
+        core::Duration & stamp,
+        core::LocalisationFSMState & fsm_state,
+        Eigen::MatrixXd & state,
+        Eigen::MatrixXd & covariance)>;
+
+public:
+  LocalisationCheckpointSaver(
+    std::shared_ptr<rclcpp::Node> node,
+    std::shared_ptr<LocalisationCheckpoint> checkpoint,
+    const double & period,
+    SnapshotFunction snapshot_function);
+
+  // can also be called outside of timer, e.g. before node shutdown
+  bool save();
+
+private:
+  std::shared_ptr<LocalisationCheckpoint> checkpoint_;
+  SnapshotFunction snapshot_function_;
+  std::shared_ptr<rclcpp::TimerBase> timer_;
+
+  core::Duration stamp_;
+  core::LocalisationFSMState fsm_state_;
+  Eigen::MatrixXd state_;
+  Eigen::MatrixXd covariance_;
+  std::mutex mutex_;
+};
+
+std::unique_ptr<LocalisationCheckpointSaver> make_checkpoint_saver(
+  std::shared_ptr<rclcpp::Node> node,
+  std::shared_ptr<LocalisationCheckpoint> checkpoint,
+  LocalisationCheckpointSaver::SnapshotFunction snapshot_function);
+
+using LocalisationCheckpointRestoreFunction = std::function<void(
+      const core::Duration & stamp,
+      const core::LocalisationFSMState & fsm_state,
+      const Eigen::MatrixXd & state,
+      const Eigen::MatrixXd & covariance)>;
+
+// Initialises filter state and FSM from latest checkpoint at startup. Returns
+// false, without calling restore function, if there is no valid checkpoint or
+// if it is older than checkpoint maximal age, filter then starts cold.
+bool restore_checkpoint(
+  std::shared_ptr<rclcpp::Node> node,
+  const LocalisationCheckpoint & checkpoint,
+  LocalisationCheckpointRestoreFunction restore_function);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_CHECKPOINT_SAVER_HPP_
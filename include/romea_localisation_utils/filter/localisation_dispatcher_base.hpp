@@ -0,0 +1,60 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_DISPATCHER_BASE_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_DISPATCHER_BASE_HPP_
+
+// std
+#include <functional>
+#include <string>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Stage placed between updater interfaces and the filter: interfaces hand over
+// a job (the filter_->process call of an observation) and the dispatcher
+// decides when and in which order jobs are run.
+class LocalisationDispatcherBase
+{
+public:
+  using Job = std::function<void ()>;
+
+public:
+  LocalisationDispatcherBase() {}
+
+  virtual ~LocalisationDispatcherBase() = default;
+
+  // returns the id used by the updater to dispatch its jobs
+  virtual size_t register_updater(const std::string & updater_name, const int & priority) = 0;
+
+  virtual void dispatch(const size_t & updater_id, const core::Duration & stamp, Job && job) = 0;
+
+  virtual core::DiagnosticReport get_report() const = 0;
+
+  // appends counters of given updater to its updater interface report
+  virtual void append_to_report(
+    const size_t & updater_id,
+    core::DiagnosticReport & report) const = 0;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_DISPATCHER_BASE_HPP_
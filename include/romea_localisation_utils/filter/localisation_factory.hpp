@@ -19,8 +19,10 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "localisation_parameters.hpp"
+#include "triple_buffer.hpp"
 #include "romea_common_utils/params/algorithm_parameters.hpp"
 #include "romea_core_localisation/LocalisationUpdaterTriggerMode.hpp"
 
@@ -115,42 +117,49 @@ std::unique_ptr<Predictor> make_predictor(std::shared_ptr<rclcpp::Node> & node)
 
 //-----------------------------------------------------------------------------
 template<class Filter>
-std::unique_ptr<Filter> make_kalman_filter(std::shared_ptr<rclcpp::Node> node)
+std::unique_ptr<Filter> make_kalman_filter(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names = {})
 {
-  return std::make_unique<Filter>(get_filter_state_pool_size(node));
+  return std::make_unique<Filter>(get_filter_state_pool_size(node, updater_names));
 }
 
 //-----------------------------------------------------------------------------
 template<class Filter>
-std::unique_ptr<Filter> make_particle_filter(std::shared_ptr<rclcpp::Node> node)
+std::unique_ptr<Filter> make_particle_filter(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names = {})
 {
   return std::make_unique<Filter>(
-    get_filter_state_pool_size(node),
+    get_filter_state_pool_size(node, updater_names),
     get_filter_number_of_particles(node));
 }
 
 //-----------------------------------------------------------------------------
 template<class Filter, core::FilterType FilterType_>
-std::unique_ptr<Filter> make_filter(std::shared_ptr<rclcpp::Node> node)
+std::unique_ptr<Filter> make_filter(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names = {})
 {
   if constexpr (FilterType_ == core::KALMAN) {
-    return make_kalman_filter<Filter>(node);
+    return make_kalman_filter<Filter>(node, updater_names);
   } else {
-    return make_particle_filter<Filter>(node);
+    return make_particle_filter<Filter>(node, updater_names);
   }
 }
 
 //-----------------------------------------------------------------------------
 template<class Filter, class Predictor, core::FilterType FilterType_>
-std::unique_ptr<Filter> make_filter(std::shared_ptr<rclcpp::Node> node)
+std::unique_ptr<Filter> make_filter(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names = {})
 {
-  auto filter = make_filter<Filter, FilterType_>(node);
+  auto filter = make_filter<Filter, FilterType_>(node, updater_names);
   auto predictor = make_predictor<Predictor, FilterType_>(node);
   filter->registerPredictor(std::move(predictor));
   return filter;
 }
 
-
 //-----------------------------------------------------------------------------
 template<class Results>
 std::unique_ptr<Results> make_kalman_results(std::shared_ptr<rclcpp::Node>/*node*/)
@@ -176,6 +185,16 @@ std::unique_ptr<Results> make_results(std::shared_ptr<rclcpp::Node> node)
   }
 }
 
+//-----------------------------------------------------------------------------
+template<class Results, core::FilterType FilterType_>
+std::unique_ptr<TripleBuffer<Results>> make_results_buffer(std::shared_ptr<rclcpp::Node> node)
+{
+  return std::make_unique<TripleBuffer<Results>>(
+    make_results<Results, FilterType_>(node),
+    make_results<Results, FilterType_>(node),
+    make_results<Results, FilterType_>(node));
+}
+
 }  // namespace ros2
 }  // namespace romea
 
@@ -0,0 +1,77 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_KLD_SAMPLING_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_KLD_SAMPLING_HPP_
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+
+namespace romea
+{
+namespace ros2
+{
+
+// KLD-sampling (Fox 2003): number of particles needed so that the KL divergence
+// between the sampled and the true posterior stays below error with the given
+// confidence, knowing the number of histogram bins occupied by the particles.
+// Core particle filters keep a fixed particle set for now, this bound is not
+// applied by the filter factories.
+class LocalisationKLDSampling
+{
+public:
+  LocalisationKLDSampling(
+    const size_t & minimal_number_of_particles,
+    const size_t & maximal_number_of_particles,
+    const double & error,
+    const double & confidence,
+    const double & position_bin_size,
+    const double & orientation_bin_size);
+
+  bool is_adaptive() const;
+
+  size_t get_minimal_number_of_particles() const;
+
+  size_t get_maximal_number_of_particles() const;
+
+  size_t compute_number_of_particles(const size_t & number_of_occupied_bins) const;
+
+  size_t compute_number_of_particles(
+    const double * x,
+    const double * y,
+    const double * yaw,
+    const size_t & number_of_particles);
+
+  size_t count_occupied_bins(
+    const double * x,
+    const double * y,
+    const double * yaw,
+    const size_t & number_of_particles);
+
+private:
+  size_t minimal_number_of_particles_;
+  size_t maximal_number_of_particles_;
+  double error_;
+  double quantile_;
+  double position_bin_size_;
+  double orientation_bin_size_;
+  std::unordered_set<uint64_t> occupied_bins_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_KLD_SAMPLING_HPP_
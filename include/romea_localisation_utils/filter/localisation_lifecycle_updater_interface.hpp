@@ -0,0 +1,223 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LIFECYCLE_UPDATER_INTERFACE_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LIFECYCLE_UPDATER_INTERFACE_HPP_
+
+// std
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+
+// ros
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+
+// romea
+#include "romea_common_utils/qos.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface_common.hpp"
+
+
+namespace romea
+{
+namespace ros2
+{
+
+// Updater interface driven by the transitions of a lifecycle node. Updater and
+// filter are loaded and callback group is allocated when node is configured,
+// subscription is created on first activation. Deactivation only stops message
+// processing, subscription and updater state are kept so that a node can switch
+// between sensor sets without reallocation. Everything is released on cleanup.
+// Active messages are processed as described in LocalisationUpdaterInterfaceCommon.
+template<typename Filter_, typename Updater_, typename Msg>
+class LocalisationLifecycleUpdaterInterface
+  : public LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>
+{
+public:
+  using Filter = Filter_;
+  using Updater = Updater_;
+  using Observation = typename Updater_::Observation;
+  using CallbackReturn =
+    rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
+public:
+  LocalisationLifecycleUpdaterInterface(
+    std::shared_ptr<rclcpp_lifecycle::LifecycleNode> node,
+    const std::string & topic_name);
+
+  CallbackReturn on_configure(
+    std::unique_ptr<Updater> updater,
+    std::shared_ptr<Filter> filter);
+
+  CallbackReturn on_activate();
+
+  CallbackReturn on_deactivate();
+
+  CallbackReturn on_cleanup();
+
+  bool is_active() const;
+
+  void process_message(typename Msg::ConstSharedPtr msg);
+
+  // an inactive updater is not expected to receive data and is always alive
+  bool heartbeat_callback(const core::Duration & duration) override;
+
+  core::DiagnosticReport get_report() override;
+
+private:
+  std::weak_ptr<rclcpp_lifecycle::LifecycleNode> node_;
+  std::string topic_name_;
+  rclcpp::CallbackGroup::SharedPtr callback_group_;
+  std::shared_ptr<rclcpp::Subscription<Msg>> sub_;
+  std::atomic<bool> is_active_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::
+LocalisationLifecycleUpdaterInterface(
+  std::shared_ptr<rclcpp_lifecycle::LifecycleNode> node,
+  const std::string & topic_name)
+: LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>(
+    node->get_node_topics_interface()->resolve_topic_name(topic_name),
+    node->get_logger(),
+    node->get_clock()),
+  node_(node),
+  topic_name_(topic_name),
+  callback_group_(nullptr),
+  sub_(nullptr),
+  is_active_(false)
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+typename LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::CallbackReturn
+LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::on_configure(
+  std::unique_ptr<Updater> updater,
+  std::shared_ptr<Filter> filter)
+{
+  auto node = node_.lock();
+  if (!node || !updater || !filter) {
+    return CallbackReturn::FAILURE;
+  }
+
+  this->load_updater(std::move(updater));
+  this->register_filter(filter);
+
+  if (!callback_group_) {
+    callback_group_ = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  }
+
+  return CallbackReturn::SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+typename LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::CallbackReturn
+LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::on_activate()
+{
+  auto node = node_.lock();
+  if (!node || !callback_group_) {
+    return CallbackReturn::FAILURE;
+  }
+
+  // subscription is kept across deactivations
+  if (!sub_) {
+    auto callback = std::bind(
+      &LocalisationLifecycleUpdaterInterface::process_message,
+      this, std::placeholders::_1);
+
+    rclcpp::SubscriptionOptions options;
+    options.callback_group = callback_group_;
+
+    sub_ = node->template create_subscription<Msg>(
+      topic_name_, best_effort(1), callback, options);
+  }
+
+  is_active_.store(true);
+  return CallbackReturn::SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+typename LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::CallbackReturn
+LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::on_deactivate()
+{
+  is_active_.store(false);
+  return CallbackReturn::SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+typename LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::CallbackReturn
+LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::on_cleanup()
+{
+  is_active_.store(false);
+  sub_.reset();
+  callback_group_.reset();
+  this->load_updater(nullptr);
+  this->register_filter(nullptr);
+  return CallbackReturn::SUCCESS;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+bool LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::is_active() const
+{
+  return is_active_.load();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::process_message(
+  typename Msg::ConstSharedPtr msg)
+{
+  if (is_active_.load(std::memory_order_relaxed)) {
+    this->process_(*msg);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+bool LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::heartbeat_callback(
+  const core::Duration & duration)
+{
+  return !is_active_.load() ||
+         LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::heartbeat_callback(duration);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+core::DiagnosticReport LocalisationLifecycleUpdaterInterface<Filter_, Updater_, Msg>::get_report()
+{
+  if (!is_active_.load()) {
+    return core::DiagnosticReport();
+  }
+  return LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::get_report();
+}
+
+//-----------------------------------------------------------------------------
+template<typename UpdaterInterface>
+std::unique_ptr<UpdaterInterface> make_lifecycle_updater_interface(
+  std::shared_ptr<rclcpp_lifecycle::LifecycleNode> node,
+  const std::string & topic_name)
+{
+  return std::make_unique<UpdaterInterface>(node, topic_name);
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LIFECYCLE_UPDATER_INTERFACE_HPP_
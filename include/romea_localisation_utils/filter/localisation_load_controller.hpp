@@ -0,0 +1,103 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LOAD_CONTROLLER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LOAD_CONTROLLER_HPP_
+
+// std
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Keeps the time spent in filter steps under a CPU budget (fraction of one core).
+// Processing times are summed over a control period, and at the end of each
+// period the shedding level (0: no decimation, 1: every updater at its minimal
+// rate) is corrected proportionally to the budget overrun. Each updater is then
+// decimated to minimal_rate + (arrival_rate - minimal_rate) * (1 - shedding_level).
+class LocalisationLoadController
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+public:
+  LocalisationLoadController(
+    const double & cpu_budget,
+    const Clock::duration & control_period);
+
+  size_t register_updater(const std::string & updater_name, const unsigned int & minimal_rate);
+
+  // returns false if message has to be dropped
+  bool accept(const size_t & updater_id, const Clock::time_point & now = Clock::now());
+
+  void record(
+    const size_t & updater_id,
+    const Clock::duration & processing_time,
+    const Clock::time_point & now = Clock::now());
+
+  double get_shedding_level() const;
+
+  double get_load() const;
+
+  size_t get_number_of_decimated_messages(const size_t & updater_id) const;
+
+  core::DiagnosticReport get_report() const;
+
+private:
+  struct UpdaterState
+  {
+    std::string updater_name;
+    double minimal_rate;
+    double arrival_period;
+    bool has_arrival;
+    Clock::time_point last_arrival_time;
+    bool has_accepted;
+    Clock::time_point last_accepted_time;
+    size_t number_of_decimated_messages;
+  };
+
+  void update_shedding_level_(const Clock::time_point & now);
+
+private:
+  double cpu_budget_;
+  Clock::duration control_period_;
+
+  mutable std::mutex mutex_;
+  std::vector<UpdaterState> updaters_;
+  bool has_period_start_;
+  Clock::time_point period_start_time_;
+  Clock::duration processing_time_;
+  double load_;
+  double shedding_level_;
+};
+
+std::shared_ptr<LocalisationLoadController> make_load_controller(
+  std::shared_ptr<rclcpp::Node> node);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LOAD_CONTROLLER_HPP_
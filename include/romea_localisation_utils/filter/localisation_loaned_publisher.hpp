@@ -0,0 +1,126 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LOANED_PUBLISHER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LOANED_PUBLISHER_HPP_
+
+// std
+#include <memory>
+#include <string>
+#include <utility>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+#include "rosidl_runtime_cpp/traits.hpp"
+
+// romea
+#include "romea_localisation_utils/conversions/observation_conversions.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Publishes fixed size observation payloads (ObservationRange, ObservationPose2D,
+// ObservationTwist2D, ...). When message type is plain and middleware can loan
+// messages, data are written in place into a borrowed message and published
+// without copy. Otherwise, as for non plain types, one preallocated message is
+// filled and published by const reference.
+// Not thread safe, data must be published from a single callback group.
+template<typename Msg>
+class LocalisationLoanedPublisher
+{
+public:
+  using Message = Msg;
+
+public:
+  LocalisationLoanedPublisher(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & topic_name,
+    const rclcpp::QoS & qos);
+
+  template<typename Data>
+  void publish(const Data & data);
+
+  size_t get_subscription_count() const;
+
+  bool is_loaning_messages() const;
+
+private:
+  std::shared_ptr<rclcpp::Publisher<Msg>> pub_;
+  bool is_loaning_messages_;
+  Msg msg_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+LocalisationLoanedPublisher<Msg>::LocalisationLoanedPublisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const rclcpp::QoS & qos)
+: pub_(node->create_publisher<Msg>(topic_name, qos)),
+  is_loaning_messages_(false),
+  msg_()
+{
+  if constexpr (rosidl_generator_traits::is_plain<Msg>::value) {
+    is_loaning_messages_ = pub_->can_loan_messages();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+template<typename Data>
+void LocalisationLoanedPublisher<Msg>::publish(const Data & data)
+{
+  if constexpr (rosidl_generator_traits::is_plain<Msg>::value) {
+    if (is_loaning_messages_) {
+      auto loaned_msg = pub_->borrow_loaned_message();
+      to_ros_msg(data, loaned_msg);
+      pub_->publish(std::move(loaned_msg));
+      return;
+    }
+  }
+
+  to_ros_msg(data, msg_);
+  pub_->publish(msg_);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+size_t LocalisationLoanedPublisher<Msg>::get_subscription_count() const
+{
+  return pub_->get_subscription_count();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+bool LocalisationLoanedPublisher<Msg>::is_loaning_messages() const
+{
+  return is_loaning_messages_;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+std::unique_ptr<LocalisationLoanedPublisher<Msg>> make_loaned_publisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const rclcpp::QoS & qos)
+{
+  return std::make_unique<LocalisationLoanedPublisher<Msg>>(node, topic_name, qos);
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_LOANED_PUBLISHER_HPP_
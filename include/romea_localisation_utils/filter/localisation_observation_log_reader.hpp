@@ -0,0 +1,97 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_LOG_READER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_LOG_READER_HPP_
+
+// std
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_observation_record.hpp"
+#include "romea_localisation_utils/filter/localisation_thread_pool.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Read only view of an observation log written by LocalisationObservationRecorder.
+// The file is mapped and its complete records are indexed by stamp and by updater
+// when opened, records are never copied. Slots that were being written when the
+// recorder stopped are skipped.
+class LocalisationObservationLogReader
+{
+public:
+  static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+public:
+  explicit LocalisationObservationLogReader(const std::string & filename);
+
+  ~LocalisationObservationLogReader();
+
+  LocalisationObservationLogReader(const LocalisationObservationLogReader &) = delete;
+  LocalisationObservationLogReader & operator=(const LocalisationObservationLogReader &) = delete;
+
+  const std::string & get_filename() const;
+
+  const std::vector<std::string> & get_updater_names() const;
+
+  size_t find_updater(const std::string & updater_name) const;
+
+  // records are sorted by stamp, records with same stamp keep their recording order
+  size_t size() const;
+
+  const ObservationRecord & get_record(const size_t & index) const;
+
+  // indexes of given updater records
+  const std::vector<size_t> & get_updater_records(const uint16_t & updater_id) const;
+
+  // index of first record whose stamp is not less than given stamp
+  size_t lower_bound(const core::Duration & stamp) const;
+
+  core::Duration get_start_stamp() const;
+
+  core::Duration get_end_stamp() const;
+
+  size_t get_number_of_incomplete_records() const;
+
+private:
+  void index_();
+
+private:
+  std::string filename_;
+  int file_descriptor_;
+  size_t mapping_size_;
+  void * mapping_;
+  const ObservationLogHeader * header_;
+
+  std::vector<std::string> updater_names_;
+  std::vector<const ObservationRecord *> records_;
+  std::vector<std::vector<size_t>> updater_records_;
+  size_t number_of_incomplete_records_;
+};
+
+// logs are opened and indexed in parallel, one file per task
+std::vector<std::unique_ptr<LocalisationObservationLogReader>> open_observation_logs(
+  const std::vector<std::string> & filenames,
+  LocalisationThreadPool & thread_pool);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_LOG_READER_HPP_
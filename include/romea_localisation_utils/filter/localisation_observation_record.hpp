@@ -0,0 +1,204 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_RECORD_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_RECORD_HPP_
+
+// std
+#include <cstdint>
+#include <type_traits>
+
+// eigen
+#include "Eigen/Core"
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Binary observation log layout: a fixed size header followed by fixed size
+// records. A record is complete when its sequence field, written last, equals
+// its position in the log plus one. In ring mode, record n is stored in slot
+// n % capacity.
+constexpr char OBSERVATION_LOG_MAGIC[8] = {'R', 'L', 'O', 'B', 'S', 'L', 'O', 'G'};
+constexpr uint32_t OBSERVATION_LOG_VERSION = 1;
+constexpr size_t OBSERVATION_LOG_MAXIMAL_NUMBER_OF_UPDATERS = 64;
+constexpr size_t OBSERVATION_LOG_MAXIMAL_UPDATER_NAME_LENGTH = 32;
+constexpr size_t OBSERVATION_RECORD_MAXIMAL_DIMENSION = 3;
+
+struct ObservationLogHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t capacity;
+  uint32_t ring_mode;
+  uint32_t number_of_updaters;
+  // number of reserved records, may exceed capacity in ring mode
+  uint64_t number_of_records;
+  char updater_names[OBSERVATION_LOG_MAXIMAL_NUMBER_OF_UPDATERS]
+  [OBSERVATION_LOG_MAXIMAL_UPDATER_NAME_LENGTH];
+};
+
+struct ObservationRecord
+{
+  uint64_t sequence;
+  int64_t stamp;
+  uint16_t updater_id;
+  uint16_t dimension;
+  uint32_t reserved;
+  double Y[OBSERVATION_RECORD_MAXIMAL_DIMENSION];
+  // row major dimension x dimension covariance
+  double R[OBSERVATION_RECORD_MAXIMAL_DIMENSION * OBSERVATION_RECORD_MAXIMAL_DIMENSION];
+  // lever arm, or initiator antenna position for ranges
+  double level_arm[3];
+  // responder antenna position for ranges
+  double auxiliary[3];
+};
+
+static_assert(std::is_trivially_copyable<ObservationRecord>::value, "");
+static_assert(sizeof(ObservationRecord) % 8 == 0, "");
+
+namespace detail
+{
+
+template<typename T, typename = void>
+struct has_level_arm : std::false_type {};
+
+template<typename T>
+struct has_level_arm<T, std::void_t<decltype(std::declval<T>().levelArm)>>: std::true_type {};
+
+template<typename T, typename = void>
+struct has_antenna_positions : std::false_type {};
+
+template<typename T>
+struct has_antenna_positions<T, std::void_t<decltype(std::declval<T>().responderPosition)>>
+  : std::true_type {};
+
+inline uint16_t write_values(const double & value, double * Y)
+{
+  Y[0] = value;
+  return 1;
+}
+
+template<typename Derived>
+uint16_t write_values(const Eigen::MatrixBase<Derived> & values, double * Y)
+{
+  const Eigen::Index size = std::min<Eigen::Index>(
+    values.size(), OBSERVATION_RECORD_MAXIMAL_DIMENSION);
+  for (Eigen::Index n = 0; n < size; ++n) {
+    Y[n] = values(n);
+  }
+  return static_cast<uint16_t>(size);
+}
+
+inline void write_covariance(const double & value, const uint16_t &, double * R)
+{
+  R[0] = value;
+}
+
+template<typename Derived>
+void write_covariance(
+  const Eigen::MatrixBase<Derived> & values,
+  const uint16_t & dimension,
+  double * R)
+{
+  for (uint16_t i = 0; i < dimension; ++i) {
+    for (uint16_t j = 0; j < dimension; ++j) {
+      R[i * dimension + j] = values(i, j);
+    }
+  }
+}
+
+inline void read_values(const double * Y, const uint16_t &, double & value)
+{
+  value = Y[0];
+}
+
+template<typename Derived>
+void read_values(const double * Y, const uint16_t & dimension, Eigen::MatrixBase<Derived> & values)
+{
+  for (uint16_t n = 0; n < dimension; ++n) {
+    values(n) = Y[n];
+  }
+}
+
+inline void read_covariance(const double * R, const uint16_t &, double & value)
+{
+  value = R[0];
+}
+
+template<typename Derived>
+void read_covariance(
+  const double * R,
+  const uint16_t & dimension,
+  Eigen::MatrixBase<Derived> & values)
+{
+  for (uint16_t i = 0; i < dimension; ++i) {
+    for (uint16_t j = 0; j < dimension; ++j) {
+      values(i, j) = R[i * dimension + j];
+    }
+  }
+}
+
+}  // namespace detail
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+void to_record(
+  const core::Duration & stamp,
+  const uint16_t & updater_id,
+  const Observation & observation,
+  ObservationRecord & record)
+{
+  record = ObservationRecord{};
+  record.stamp = stamp.count();
+  record.updater_id = updater_id;
+  record.dimension = detail::write_values(observation.Y(), record.Y);
+  detail::write_covariance(observation.R(), record.dimension, record.R);
+
+  if constexpr (detail::has_level_arm<Observation>::value) {
+    Eigen::Map<Eigen::Vector3d>(record.level_arm) = observation.levelArm;
+  }
+
+  if constexpr (detail::has_antenna_positions<Observation>::value) {
+    Eigen::Map<Eigen::Vector3d>(record.level_arm) = observation.initiatorPosition;
+    Eigen::Map<Eigen::Vector3d>(record.auxiliary) = observation.responderPosition;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+void from_record(const ObservationRecord & record, Observation & observation)
+{
+  detail::read_values(record.Y, record.dimension, observation.Y());
+  detail::read_covariance(record.R, record.dimension, observation.R());
+
+  if constexpr (detail::has_level_arm<Observation>::value) {
+    observation.levelArm = Eigen::Map<const Eigen::Vector3d>(record.level_arm);
+  }
+
+  if constexpr (detail::has_antenna_positions<Observation>::value) {
+    observation.initiatorPosition = Eigen::Map<const Eigen::Vector3d>(record.level_arm);
+    observation.responderPosition = Eigen::Map<const Eigen::Vector3d>(record.auxiliary);
+  }
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_RECORD_HPP_
@@ -0,0 +1,113 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_RECORDER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_RECORDER_HPP_
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_record.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Records filter inputs into a memory mapped binary log (see
+// localisation_observation_record.hpp). The file is preallocated for capacity
+// records. Writers reserve slots with an atomic counter and never block. In
+// append mode records beyond capacity are dropped, in ring mode the oldest
+// records are overwritten so that the log holds the latest inputs. The mapping
+// is shared, so records written before a crash are kept by the kernel. An
+// existing non empty log is never overwritten, construction throws instead.
+class LocalisationObservationRecorder
+{
+public:
+  LocalisationObservationRecorder(
+    const std::string & filename,
+    const size_t & capacity,
+    const bool & ring_mode);
+
+  ~LocalisationObservationRecorder();
+
+  LocalisationObservationRecorder(const LocalisationObservationRecorder &) = delete;
+  LocalisationObservationRecorder & operator=(const LocalisationObservationRecorder &) = delete;
+
+  uint16_t register_updater(const std::string & updater_name);
+
+  template<typename Observation>
+  void record(
+    const uint16_t & updater_id,
+    const core::Duration & stamp,
+    const Observation & observation);
+
+  void record(const ObservationRecord & record);
+
+  // forces written records to disk
+  void flush();
+
+  size_t get_capacity() const;
+
+  uint64_t get_number_of_records() const;
+
+  uint64_t get_number_of_dropped_records() const;
+
+  core::DiagnosticReport get_report() const;
+
+private:
+  std::string filename_;
+  int file_descriptor_;
+  size_t mapping_size_;
+  void * mapping_;
+  ObservationLogHeader * header_;
+  ObservationRecord * records_;
+  size_t capacity_;
+  bool ring_mode_;
+
+  std::mutex registration_mutex_;
+  std::atomic<uint64_t> number_of_records_;
+  std::atomic<uint64_t> number_of_dropped_records_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+void LocalisationObservationRecorder::record(
+  const uint16_t & updater_id,
+  const core::Duration & stamp,
+  const Observation & observation)
+{
+  ObservationRecord observation_record;
+  to_record(stamp, updater_id, observation, observation_record);
+  record(observation_record);
+}
+
+// log filename parameter is suffixed with start date and time, so that each run
+// (e.g. a respawn after a crash) writes its own log
+std::shared_ptr<LocalisationObservationRecorder> make_observation_recorder(
+  std::shared_ptr<rclcpp::Node> node);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_RECORDER_HPP_
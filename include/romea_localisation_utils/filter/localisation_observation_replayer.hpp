@@ -0,0 +1,166 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_REPLAYER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_REPLAYER_HPP_
+
+// std
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_observation_log_reader.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Replays observation logs into a filter built with make_filter. Updaters built
+// with make_exteroceptive_updater or make_proprioceptive_updater are registered
+// under the name they were recorded with. Records of several logs are merged by
+// stamp, records of unregistered updaters are skipped.
+template<typename Filter_>
+class LocalisationObservationReplayer
+{
+public:
+  using Filter = Filter_;
+  using Handler = std::function<void (const ObservationRecord &)>;
+
+public:
+  explicit LocalisationObservationReplayer(std::shared_ptr<Filter> filter);
+
+  template<typename Updater>
+  void register_updater(const std::string & updater_name, std::unique_ptr<Updater> updater);
+
+  // replays records whose stamps are in [start, end) and returns their number
+  size_t replay(
+    const std::vector<const LocalisationObservationLogReader *> & readers,
+    const core::Duration & start = core::Duration::min(),
+    const core::Duration & end = core::Duration::max());
+
+  size_t get_number_of_skipped_records() const;
+
+private:
+  std::shared_ptr<Filter> filter_;
+  std::map<std::string, Handler> handlers_;
+  size_t number_of_skipped_records_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Filter_>
+LocalisationObservationReplayer<Filter_>::LocalisationObservationReplayer(
+  std::shared_ptr<Filter> filter)
+: filter_(filter),
+  handlers_(),
+  number_of_skipped_records_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_>
+template<typename Updater>
+void LocalisationObservationReplayer<Filter_>::register_updater(
+  const std::string & updater_name,
+  std::unique_ptr<Updater> updater)
+{
+  std::shared_ptr<Updater> shared_updater = std::move(updater);
+  handlers_[updater_name] =
+    [filter = filter_.get(), updater = shared_updater](const ObservationRecord & record)
+    {
+      typename Updater::Observation observation;
+      from_record(record, observation);
+
+      auto updateFunction = std::bind(
+        &Updater::update,
+        updater.get(),
+        std::placeholders::_1,
+        std::move(observation),
+        std::placeholders::_2,
+        std::placeholders::_3);
+
+      filter->process(core::Duration(record.stamp), std::move(updateFunction));
+    };
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_>
+size_t LocalisationObservationReplayer<Filter_>::replay(
+  const std::vector<const LocalisationObservationLogReader *> & readers,
+  const core::Duration & start,
+  const core::Duration & end)
+{
+  // updater ids are specific to each log
+  std::vector<std::vector<const Handler *>> handlers(readers.size());
+  for (size_t n = 0; n < readers.size(); ++n) {
+    for (const auto & updater_name : readers[n]->get_updater_names()) {
+      auto it = handlers_.find(updater_name);
+      handlers[n].push_back(it != handlers_.end() ? &it->second : nullptr);
+    }
+  }
+
+  // k-way merge on (stamp, log index, record index)
+  using Cursor = std::tuple<int64_t, size_t, size_t>;
+  std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> cursors;
+  for (size_t n = 0; n < readers.size(); ++n) {
+    size_t index = readers[n]->lower_bound(start);
+    if (index < readers[n]->size()) {
+      cursors.emplace(readers[n]->get_record(index).stamp, n, index);
+    }
+  }
+
+  size_t number_of_replayed_records = 0;
+  while (!cursors.empty()) {
+    auto [stamp, reader_index, record_index] = cursors.top();
+    cursors.pop();
+
+    if (stamp >= end.count()) {
+      continue;
+    }
+
+    const auto & reader = *readers[reader_index];
+    const auto & record = reader.get_record(record_index);
+    const Handler * handler = handlers[reader_index][record.updater_id];
+    if (handler) {
+      (*handler)(record);
+      ++number_of_replayed_records;
+    } else {
+      ++number_of_skipped_records_;
+    }
+
+    if (++record_index < reader.size()) {
+      cursors.emplace(reader.get_record(record_index).stamp, reader_index, record_index);
+    }
+  }
+
+  return number_of_replayed_records;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_>
+size_t LocalisationObservationReplayer<Filter_>::get_number_of_skipped_records() const
+{
+  return number_of_skipped_records_;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_OBSERVATION_REPLAYER_HPP_
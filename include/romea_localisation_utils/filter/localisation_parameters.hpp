@@ -18,12 +18,15 @@
 // std
 #include <string>
 #include <memory>
+#include <vector>
 
 // ros
 #include "rclcpp/rclcpp.hpp"
 
 // romea
 #include "romea_core_filtering/FilterType.hpp"
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
+#include "romea_localisation_utils/conversions/range_anchor_table.hpp"
 
 
 namespace romea
@@ -80,7 +83,21 @@ size_t get_filter_number_of_particles(std::shared_ptr<rclcpp::Node> node);
 
 void declare_filter_state_pool_size(std::shared_ptr<rclcpp::Node> node);
 
-size_t get_filter_state_pool_size(std::shared_ptr<rclcpp::Node> node);
+// when state pool size is zero, it is derived from minimal rates of given updaters,
+// their minimal rate parameters must have been declared
+size_t get_filter_state_pool_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names = {});
+
+void declare_filter_maximal_observation_latency(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_filter_maximal_observation_latency(std::shared_ptr<rclcpp::Node> node);
+
+size_t compute_filter_state_pool_size(
+  const std::vector<unsigned int> & updater_minimal_rates,
+  const double & maximal_observation_latency);
 
 
 // void declare_proprioceptive_updater_parameters(
@@ -150,6 +167,203 @@ double get_updater_mahalanobis_distance_rejection_threshold(
   std::shared_ptr<rclcpp::Node> node,
   std::string updater_name);
 
+void declare_updater_maximal_batch_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const unsigned int & default_value);
+
+size_t get_updater_maximal_batch_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name);
+
+// batch window in seconds, ranges stamped within window of first one are batched
+void declare_updater_batch_window(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const double & default_value);
+
+double get_updater_batch_window(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name);
+
+// observations of higher priority updaters are dispatched first under overload
+void declare_updater_priority(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const int & default_value);
+
+int get_updater_priority(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name);
+
+// preintegration interval in seconds, zero means no preintegration
+void declare_updater_preintegration_interval(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const double & default_value);
+
+double get_updater_preintegration_interval(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name);
+
+// anchors are read from <updater>.anchors_filename if not empty and from
+// <updater>.anchors.<anchor_id>: [x, y, z] parameters
+void declare_updater_range_anchors(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name);
+
+RangeAnchorTable get_updater_range_anchors(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name);
+
+void declare_extrapolation_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_rate,
+  const double & default_maximal_horizon);
+
+void declare_extrapolation_rate(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_extrapolation_rate(std::shared_ptr<rclcpp::Node> node);
+
+void declare_extrapolation_maximal_horizon(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_extrapolation_maximal_horizon(std::shared_ptr<rclcpp::Node> node);
+
+void declare_dispatcher_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const unsigned int & default_maximal_queue_size,
+  const double & default_maximal_delay);
+
+void declare_dispatcher_maximal_queue_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const unsigned int & default_value);
+
+size_t get_dispatcher_maximal_queue_size(std::shared_ptr<rclcpp::Node> node);
+
+void declare_dispatcher_maximal_delay(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_dispatcher_maximal_delay(std::shared_ptr<rclcpp::Node> node);
+
+// CPU budget is the fraction of one core that filter steps may use
+void declare_load_controller_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_cpu_budget,
+  const double & default_period);
+
+void declare_load_controller_cpu_budget(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_load_controller_cpu_budget(std::shared_ptr<rclcpp::Node> node);
+
+void declare_load_controller_period(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_load_controller_period(std::shared_ptr<rclcpp::Node> node);
+
+// reorder window in seconds, zero waits for all updaters (deterministic replay)
+void declare_sequencer_reorder_window(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_sequencer_reorder_window(std::shared_ptr<rclcpp::Node> node);
+
+// sizes the pool used to decode observation logs, core filters run single threaded
+void declare_thread_pool_number_of_threads(
+  std::shared_ptr<rclcpp::Node> node,
+  const unsigned int & default_value);
+
+size_t get_thread_pool_number_of_threads(std::shared_ptr<rclcpp::Node> node);
+
+// a negative cpu means that wait set runtime thread is not pinned
+void declare_runtime_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & default_cpu,
+  const double & default_wait_timeout);
+
+void declare_runtime_cpu(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & default_value);
+
+int get_runtime_cpu(std::shared_ptr<rclcpp::Node> node);
+
+void declare_runtime_wait_timeout(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_runtime_wait_timeout(std::shared_ptr<rclcpp::Node> node);
+
+// capacity is the number of records preallocated in the observation log, in ring
+// mode the oldest records are overwritten once it is full
+void declare_recorder_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_filename,
+  const int & default_capacity,
+  const bool & default_ring_mode);
+
+void declare_recorder_filename(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_value);
+
+std::string get_recorder_filename(std::shared_ptr<rclcpp::Node> node);
+
+void declare_recorder_capacity(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & default_value);
+
+size_t get_recorder_capacity(std::shared_ptr<rclcpp::Node> node);
+
+void declare_recorder_ring_mode(
+  std::shared_ptr<rclcpp::Node> node,
+  const bool & default_value);
+
+bool get_recorder_ring_mode(std::shared_ptr<rclcpp::Node> node);
+
+// period at which filter state is checkpointed, a checkpoint older than maximal
+// age is not restored at startup
+void declare_checkpoint_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_filename,
+  const double & default_period,
+  const double & default_maximal_age);
+
+void declare_checkpoint_filename(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_value);
+
+std::string get_checkpoint_filename(std::shared_ptr<rclcpp::Node> node);
+
+void declare_checkpoint_period(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_checkpoint_period(std::shared_ptr<rclcpp::Node> node);
+
+void declare_checkpoint_maximal_age(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_checkpoint_maximal_age(std::shared_ptr<rclcpp::Node> node);
+
+// status is republished after keepalive period (in seconds) without transition
+void declare_status_keepalive_period(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value);
+
+double get_status_keepalive_period(std::shared_ptr<rclcpp::Node> node);
+
+// lever arms are read from lever_arms.<frame_id>: [x, y, z] parameters
+void declare_lever_arms(std::shared_ptr<rclcpp::Node> node);
+
+LeverArmRegistry get_lever_arms(std::shared_ptr<rclcpp::Node> node);
+
 }  // namespace ros2
 }  // namespace romea
 
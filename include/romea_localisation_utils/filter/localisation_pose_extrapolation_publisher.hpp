@@ -0,0 +1,84 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_EXTRAPOLATION_PUBLISHER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_EXTRAPOLATION_PUBLISHER_HPP_
+
+// std
+#include <memory>
+#include <string>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_msgs/msg/observation_pose2_d_stamped.hpp"
+#include "romea_localisation_utils/filter/localisation_pose_extrapolator.hpp"
+#include "romea_localisation_utils/filter/localisation_stamped_publisher.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Publishes, at a fixed rate, the pose of the last filter results extrapolated
+// to the current time with the most recent twist observation.
+class LocalisationPoseExtrapolationPublisher
+{
+public:
+  using Message = romea_localisation_msgs::msg::ObservationPose2DStamped;
+
+public:
+  LocalisationPoseExtrapolationPublisher(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & topic_name,
+    const std::string & frame_id,
+    const double & rate,
+    const core::Duration & maximal_horizon);
+
+  void update_pose(const core::Duration & stamp, const core::Pose2D & pose);
+
+  void update_twist(const core::Duration & stamp, const core::Twist2D & twist);
+
+  template<typename Results>
+  void update_results(const core::Duration & stamp, const Results & results);
+
+private:
+  void timer_callback_();
+
+private:
+  LocalisationPoseExtrapolator extrapolator_;
+  rclcpp::Clock::SharedPtr clock_;
+  LocalisationStampedPublisher<Message> pub_;
+  std::shared_ptr<rclcpp::TimerBase> timer_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Results>
+void LocalisationPoseExtrapolationPublisher::update_results(
+  const core::Duration & stamp,
+  const Results & results)
+{
+  update_pose(stamp, results.toPose2D());
+}
+
+std::unique_ptr<LocalisationPoseExtrapolationPublisher> make_pose_extrapolation_publisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const std::string & frame_id);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_EXTRAPOLATION_PUBLISHER_HPP_
@@ -0,0 +1,81 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_EXTRAPOLATOR_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_EXTRAPOLATOR_HPP_
+
+// std
+#include <cstdint>
+
+// romea
+#include "romea_core_common/geometry/Pose2D.hpp"
+#include "romea_core_common/geometry/Twist2D.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_localisation_utils/filter/seqlock.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Extrapolates the last filter pose with the most recent twist observation.
+// No pose is returned when the last pose is older than the maximal horizon and
+// a twist older than the maximal horizon is not used for extrapolation.
+// Pose and twist can be updated and read concurrently from different threads.
+class LocalisationPoseExtrapolator
+{
+public:
+  explicit LocalisationPoseExtrapolator(const core::Duration & maximal_horizon);
+
+  void update_pose(const core::Duration & stamp, const core::Pose2D & pose);
+
+  void update_twist(const core::Duration & stamp, const core::Twist2D & twist);
+
+  bool extrapolate(const core::Duration & stamp, core::Pose2D & pose) const;
+
+  static core::Pose2D extrapolate(
+    const core::Pose2D & pose,
+    const core::Twist2D & twist,
+    const double & dt);
+
+private:
+  struct StampedPose
+  {
+    bool valid;
+    int64_t stamp;
+    double x;
+    double y;
+    double yaw;
+    double covariance[9];
+  };
+
+  struct StampedTwist
+  {
+    bool valid;
+    int64_t stamp;
+    double linear_speed_x;
+    double linear_speed_y;
+    double angular_speed;
+    double covariance[9];
+  };
+
+  core::Duration maximal_horizon_;
+  Seqlock<StampedPose> pose_;
+  Seqlock<StampedTwist> twist_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_EXTRAPOLATOR_HPP_
@@ -0,0 +1,400 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_TWIST_UPDATER_INTERFACE_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_TWIST_UPDATER_INTERFACE_HPP_
+
+// std
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// romea
+#include "romea_common_utils/qos.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface_base.hpp"
+#include "romea_localisation_utils/conversions/observation_pose_conversions.hpp"
+#include "romea_localisation_utils/conversions/observation_twist_conversions.hpp"
+#include "romea_localisation_utils/conversions/stamp_conversions.hpp"
+
+
+namespace romea
+{
+namespace ros2
+{
+
+// Updater interface for sensors (lidar or visual odometry) publishing a pose and
+// a twist with the same stamp. Messages with matching stamps are applied in a
+// single filter step (twist update then pose update). At most one observation
+// is kept pending: it is processed alone, in stamp order, as soon as a message
+// of the same kind or a newer message of the other kind arrives, or on heartbeat.
+// Updaters and filter can be replaced while messages are processed (see
+// LocalisationUpdaterInterfaceCommon).
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+class LocalisationPoseTwistUpdaterInterface : public LocalisationUpdaterInterfaceBase
+{
+public:
+  using Filter = Filter_;
+  using PoseUpdater = PoseUpdater_;
+  using TwistUpdater = TwistUpdater_;
+  using PoseObservation = typename PoseUpdater_::Observation;
+  using TwistObservation = typename TwistUpdater_::Observation;
+  using PoseMsg = romea_localisation_msgs::msg::ObservationPose2DStamped;
+  using TwistMsg = romea_localisation_msgs::msg::ObservationTwist2DStamped;
+
+public:
+  LocalisationPoseTwistUpdaterInterface(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & pose_topic_name,
+    const std::string & twist_topic_name);
+
+  void process_pose_message(PoseMsg::ConstSharedPtr msg);
+
+  void process_twist_message(TwistMsg::ConstSharedPtr msg);
+
+  void flush();
+
+  void load_updaters(
+    std::unique_ptr<PoseUpdater> pose_updater,
+    std::unique_ptr<TwistUpdater> twist_updater);
+
+  void register_filter(std::shared_ptr<Filter> filter);
+
+  // paired observations are recorded separately, each one under its updater name
+  void register_recorder(
+    std::shared_ptr<LocalisationObservationRecorder> recorder,
+    const std::string & pose_updater_name,
+    const std::string & twist_updater_name);
+
+  bool heartbeat_callback(const core::Duration & duration) override;
+
+  core::DiagnosticReport get_report() override;
+
+private:
+  void process_pose_();
+
+  void process_twist_();
+
+  void process_pose_and_twist_();
+
+  void pair_or_process_oldest_();
+
+private:
+  std::shared_ptr<Filter> filter_;
+  std::shared_ptr<PoseUpdater> pose_updater_;
+  std::shared_ptr<TwistUpdater> twist_updater_;
+  std::shared_ptr<rclcpp::Subscription<PoseMsg>> pose_sub_;
+  std::shared_ptr<rclcpp::Subscription<TwistMsg>> twist_sub_;
+  std::shared_ptr<LocalisationObservationRecorder> recorder_;
+  uint16_t pose_recorder_id_;
+  uint16_t twist_recorder_id_;
+
+  bool has_pending_pose_;
+  core::Duration pending_pose_stamp_;
+  PoseObservation pending_pose_;
+
+  bool has_pending_twist_;
+  core::Duration pending_twist_stamp_;
+  TwistObservation pending_twist_;
+
+  std::mutex mutex_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+LocalisationPoseTwistUpdaterInterface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & pose_topic_name,
+  const std::string & twist_topic_name)
+: LocalisationUpdaterInterfaceBase(),
+  filter_(nullptr),
+  pose_updater_(nullptr),
+  twist_updater_(nullptr),
+  pose_sub_(),
+  twist_sub_(),
+  recorder_(nullptr),
+  pose_recorder_id_(0),
+  twist_recorder_id_(0),
+  has_pending_pose_(false),
+  pending_pose_stamp_(),
+  pending_pose_(),
+  has_pending_twist_(false),
+  pending_twist_stamp_(),
+  pending_twist_(),
+  mutex_()
+{
+  // both subscriptions share a callback group, pairing is done sequentially
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  auto pose_callback = std::bind(
+    &LocalisationPoseTwistUpdaterInterface::process_pose_message,
+    this, std::placeholders::_1);
+
+  auto twist_callback = std::bind(
+    &LocalisationPoseTwistUpdaterInterface::process_twist_message,
+    this, std::placeholders::_1);
+
+  pose_sub_ = node->create_subscription<PoseMsg>(
+    pose_topic_name, best_effort(1), pose_callback, options);
+
+  twist_sub_ = node->create_subscription<TwistMsg>(
+    twist_topic_name, best_effort(1), twist_callback, options);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::load_updaters(
+  std::unique_ptr<PoseUpdater> pose_updater,
+  std::unique_ptr<TwistUpdater> twist_updater)
+{
+  std::atomic_store(&pose_updater_, std::shared_ptr<PoseUpdater>(std::move(pose_updater)));
+  std::atomic_store(&twist_updater_, std::shared_ptr<TwistUpdater>(std::move(twist_updater)));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::register_filter(
+  std::shared_ptr<Filter> filter)
+{
+  std::atomic_store(&filter_, filter);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+register_recorder(
+  std::shared_ptr<LocalisationObservationRecorder> recorder,
+  const std::string & pose_updater_name,
+  const std::string & twist_updater_name)
+{
+  pose_recorder_id_ = recorder->register_updater(pose_updater_name);
+  twist_recorder_id_ = recorder->register_updater(twist_updater_name);
+  recorder_ = recorder;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+process_pose_message(PoseMsg::ConstSharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (has_pending_pose_) {
+    process_pose_();
+  }
+
+  pending_pose_stamp_ = extract_stamp(*msg);
+  extract_obs(*msg, pending_pose_);
+  has_pending_pose_ = true;
+  pair_or_process_oldest_();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+process_twist_message(TwistMsg::ConstSharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (has_pending_twist_) {
+    process_twist_();
+  }
+
+  pending_twist_stamp_ = extract_stamp(*msg);
+  extract_obs(*msg, pending_twist_);
+  has_pending_twist_ = true;
+  pair_or_process_oldest_();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+pair_or_process_oldest_()
+{
+  // streams are in stamp order, the oldest observation will never be paired
+  if (!has_pending_pose_ || !has_pending_twist_) {
+    return;
+  }
+
+  if (pending_pose_stamp_ == pending_twist_stamp_) {
+    process_pose_and_twist_();
+  } else if (pending_twist_stamp_ < pending_pose_stamp_) {
+    process_twist_();
+  } else {
+    process_pose_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (has_pending_twist_) {
+    process_twist_();
+  }
+
+  if (has_pending_pose_) {
+    process_pose_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::process_pose_()
+{
+  has_pending_pose_ = false;
+
+  std::shared_ptr<PoseUpdater> pose_updater = std::atomic_load(&pose_updater_);
+  std::shared_ptr<Filter> filter = std::atomic_load(&filter_);
+  if (!pose_updater || !filter) {
+    return;
+  }
+
+  if (recorder_) {
+    recorder_->record(pose_recorder_id_, pending_pose_stamp_, pending_pose_);
+  }
+
+  auto updateFunction = std::bind(
+    &PoseUpdater::update,
+    std::move(pose_updater),
+    std::placeholders::_1,
+    std::move(pending_pose_),
+    std::placeholders::_2,
+    std::placeholders::_3);
+
+  filter->process(pending_pose_stamp_, std::move(updateFunction));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::process_twist_()
+{
+  has_pending_twist_ = false;
+
+  std::shared_ptr<TwistUpdater> twist_updater = std::atomic_load(&twist_updater_);
+  std::shared_ptr<Filter> filter = std::atomic_load(&filter_);
+  if (!twist_updater || !filter) {
+    return;
+  }
+
+  if (recorder_) {
+    recorder_->record(twist_recorder_id_, pending_twist_stamp_, pending_twist_);
+  }
+
+  auto updateFunction = std::bind(
+    &TwistUpdater::update,
+    std::move(twist_updater),
+    std::placeholders::_1,
+    std::move(pending_twist_),
+    std::placeholders::_2,
+    std::placeholders::_3);
+
+  filter->process(pending_twist_stamp_, std::move(updateFunction));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+void LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+process_pose_and_twist_()
+{
+  has_pending_pose_ = false;
+  has_pending_twist_ = false;
+
+  std::shared_ptr<PoseUpdater> pose_updater = std::atomic_load(&pose_updater_);
+  std::shared_ptr<TwistUpdater> twist_updater = std::atomic_load(&twist_updater_);
+  std::shared_ptr<Filter> filter = std::atomic_load(&filter_);
+  if (!pose_updater || !twist_updater || !filter) {
+    return;
+  }
+
+  if (recorder_) {
+    recorder_->record(twist_recorder_id_, pending_twist_stamp_, pending_twist_);
+    recorder_->record(pose_recorder_id_, pending_pose_stamp_, pending_pose_);
+  }
+
+  // twist is applied first so that pose update sees the current motion
+  auto updateFunction =
+    [pose_updater = std::move(pose_updater),
+    twist_updater = std::move(twist_updater),
+    pose = std::move(pending_pose_),
+    twist = std::move(pending_twist_)](
+    const core::Duration & duration, auto && ... args)
+    {
+      twist_updater->update(duration, twist, args ...);
+      pose_updater->update(duration, pose, args ...);
+    };
+
+  filter->process(pending_pose_stamp_, std::move(updateFunction));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+bool LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::
+heartbeat_callback(const core::Duration & duration)
+{
+  flush();
+  std::shared_ptr<PoseUpdater> pose_updater = std::atomic_load(&pose_updater_);
+  std::shared_ptr<TwistUpdater> twist_updater = std::atomic_load(&twist_updater_);
+  bool pose_is_alive = !pose_updater || pose_updater->heartBeatCallback(duration);
+  bool twist_is_alive = !twist_updater || twist_updater->heartBeatCallback(duration);
+  return pose_is_alive && twist_is_alive;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename PoseUpdater_, typename TwistUpdater_>
+core::DiagnosticReport
+LocalisationPoseTwistUpdaterInterface<Filter_, PoseUpdater_, TwistUpdater_>::get_report()
+{
+  core::DiagnosticReport report;
+  std::shared_ptr<PoseUpdater> pose_updater = std::atomic_load(&pose_updater_);
+  if (pose_updater) {
+    report = pose_updater->getReport();
+  }
+
+  std::shared_ptr<TwistUpdater> twist_updater = std::atomic_load(&twist_updater_);
+  if (twist_updater) {
+    core::DiagnosticReport twist_report = twist_updater->getReport();
+    report.diagnostics.insert(
+      report.diagnostics.end(), twist_report.diagnostics.begin(), twist_report.diagnostics.end());
+    report.info.insert(twist_report.info.begin(), twist_report.info.end());
+  }
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+template<typename UpdaterInterface>
+std::unique_ptr<UpdaterInterface> make_pose_twist_updater_interface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & pose_topic_name,
+  const std::string & twist_topic_name,
+  std::shared_ptr<typename UpdaterInterface::Filter> filter,
+  std::unique_ptr<typename UpdaterInterface::PoseUpdater> pose_updater,
+  std::unique_ptr<typename UpdaterInterface::TwistUpdater> twist_updater)
+{
+  auto interface = std::make_unique<UpdaterInterface>(node, pose_topic_name, twist_topic_name);
+  interface->load_updaters(std::move(pose_updater), std::move(twist_updater));
+  interface->register_filter(filter);
+  return interface;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_POSE_TWIST_UPDATER_INTERFACE_HPP_
@@ -0,0 +1,249 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PREINTEGRATED_UPDATER_INTERFACE_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PREINTEGRATED_UPDATER_INTERFACE_HPP_
+
+// std
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// romea
+#include "romea_common_utils/qos.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+#include "romea_localisation_utils/filter/localisation_preintegrator.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface_base.hpp"
+#include "romea_localisation_utils/conversions/observation_conversions.hpp"
+
+
+namespace romea
+{
+namespace ros2
+{
+
+// Proprioceptive updater interface handing the filter one preintegrated
+// observation per interval instead of one observation per message. Preintegrated
+// observation is stamped at interval start, it is then inserted in filter history
+// about one interval late. Pending samples are also flushed on heartbeat and can
+// be flushed before each exteroceptive update (see
+// LocalisationUpdaterInterface::register_flush_callback). Updater and filter can
+// be replaced while messages are processed (see LocalisationUpdaterInterfaceCommon).
+template<typename Filter_, typename Updater_, typename Msg>
+class LocalisationPreintegratedUpdaterInterface : public LocalisationUpdaterInterfaceBase
+{
+public:
+  using Filter = Filter_;
+  using Updater = Updater_;
+  using Observation = typename Updater_::Observation;
+
+public:
+  LocalisationPreintegratedUpdaterInterface(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & topic_name,
+    const double & preintegration_interval);
+
+  void process_message(typename Msg::ConstSharedPtr msg);
+
+  void flush();
+
+  void load_updater(std::unique_ptr<Updater> updater);
+
+  void register_filter(std::shared_ptr<Filter> filter);
+
+  // preintegrated observations and late samples are recorded as processed
+  void register_recorder(
+    std::shared_ptr<LocalisationObservationRecorder> recorder,
+    const std::string & updater_name);
+
+  bool heartbeat_callback(const core::Duration & duration) override;
+
+  core::DiagnosticReport get_report() override;
+
+private:
+  void process_(const core::Duration & duration, Observation && observation);
+
+  void flush_();
+
+private:
+  std::shared_ptr<Filter> filter_;
+  std::shared_ptr<Updater> updater_;
+  std::shared_ptr<rclcpp::Subscription<Msg>> sub_;
+  std::shared_ptr<LocalisationObservationRecorder> recorder_;
+  uint16_t recorder_id_;
+
+  core::Duration preintegration_interval_;
+  LocalisationPreintegrator<Observation> preintegrator_;
+  std::mutex mutex_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::
+LocalisationPreintegratedUpdaterInterface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const double & preintegration_interval)
+: LocalisationUpdaterInterfaceBase(),
+  filter_(nullptr),
+  updater_(nullptr),
+  sub_(),
+  recorder_(nullptr),
+  recorder_id_(0),
+  preintegration_interval_(core::durationFromSecond(preintegration_interval)),
+  preintegrator_(),
+  mutex_()
+{
+  auto callback = std::bind(
+    &LocalisationPreintegratedUpdaterInterface::process_message,
+    this, std::placeholders::_1);
+
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  sub_ = node->create_subscription<Msg>(topic_name, best_effort(1), callback, options);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::load_updater(
+  std::unique_ptr<Updater> updater)
+{
+  std::atomic_store(&updater_, std::shared_ptr<Updater>(std::move(updater)));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::register_filter(
+  std::shared_ptr<Filter> filter)
+{
+  std::atomic_store(&filter_, filter);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::register_recorder(
+  std::shared_ptr<LocalisationObservationRecorder> recorder,
+  const std::string & updater_name)
+{
+  recorder_id_ = recorder->register_updater(updater_name);
+  recorder_ = recorder;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::process_message(
+  typename Msg::ConstSharedPtr msg)
+{
+  core::Duration duration = extract_stamp(*msg);
+  Observation observation = extract_obs<Observation>(*msg);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!preintegrator_.add(duration, observation)) {
+    // late sample cannot be preintegrated, filter inserts it in its history
+    process_(duration, std::move(observation));
+  } else if (preintegrator_.get_time_span() >= preintegration_interval_) {
+    flush_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  flush_();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::flush_()
+{
+  if (!preintegrator_.empty()) {
+    core::Duration duration = preintegrator_.get_stamp();
+    process_(duration, preintegrator_.integrate());
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::process_(
+  const core::Duration & duration,
+  Observation && observation)
+{
+  // both instances are kept alive until update is done, even if swapped meanwhile
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  std::shared_ptr<Filter> filter = std::atomic_load(&filter_);
+  if (!updater || !filter) {
+    return;
+  }
+
+  if (recorder_) {
+    recorder_->record(recorder_id_, duration, observation);
+  }
+
+  auto updateFunction = std::bind(
+    &Updater::update,
+    std::move(updater),
+    std::placeholders::_1,
+    std::move(observation),
+    std::placeholders::_2,
+    std::placeholders::_3);
+
+  filter->process(duration, std::move(updateFunction));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+bool LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::heartbeat_callback(
+  const core::Duration & duration)
+{
+  flush();
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  return !updater || updater->heartBeatCallback(duration);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+core::DiagnosticReport LocalisationPreintegratedUpdaterInterface<Filter_, Updater_, Msg>::
+get_report()
+{
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  if (!updater) {
+    return core::DiagnosticReport();
+  }
+  return updater->getReport();
+}
+
+//-----------------------------------------------------------------------------
+template<typename UpdaterInterface>
+std::unique_ptr<UpdaterInterface> make_preintegrated_updater_interface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const double & preintegration_interval,
+  std::shared_ptr<typename UpdaterInterface::Filter> filter,
+  std::unique_ptr<typename UpdaterInterface::Updater> updater)
+{
+  auto interface = std::make_unique<UpdaterInterface>(node, topic_name, preintegration_interval);
+  interface->load_updater(std::move(updater));
+  interface->register_filter(filter);
+  return interface;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PREINTEGRATED_UPDATER_INTERFACE_HPP_
@@ -0,0 +1,170 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PREINTEGRATOR_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PREINTEGRATOR_HPP_
+
+// std
+#include <cstddef>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Accumulates proprioceptive observations (speeds) between two filter steps and
+// returns their time weighted mean. As in prediction, each sample is held until
+// the next one. Mean observation is stamped at interval start, so once held over
+// [start, end] it integrates to the same motion as the samples. Samples are
+// assumed independent, the covariance of the mean is sum(R_i * dt_i^2) / T^2.
+// Observation must provide Y() and R() (scalars or Eigen matrices); other fields
+// (level arm, ...) are taken from the last sample.
+template<typename Observation>
+class LocalisationPreintegrator
+{
+public:
+  LocalisationPreintegrator();
+
+  // returns false if sample is older than the previous one, it is then ignored
+  bool add(const core::Duration & stamp, const Observation & observation);
+
+  bool empty() const;
+
+  size_t get_number_of_samples() const;
+
+  core::Duration get_time_span() const;
+
+  // stamp of interval start
+  core::Duration get_stamp() const;
+
+  // mean observation stamped at get_stamp(), integration restarts from the last sample
+  Observation integrate();
+
+  void reset();
+
+private:
+  bool has_sample_;
+  core::Duration start_stamp_;
+  core::Duration last_stamp_;
+  Observation last_;
+  Observation sum_;
+  double time_span_;
+  size_t number_of_samples_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+LocalisationPreintegrator<Observation>::LocalisationPreintegrator()
+: has_sample_(false),
+  start_stamp_(),
+  last_stamp_(),
+  last_(),
+  sum_(),
+  time_span_(0),
+  number_of_samples_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+bool LocalisationPreintegrator<Observation>::add(
+  const core::Duration & stamp,
+  const Observation & observation)
+{
+  if (!has_sample_) {
+    has_sample_ = true;
+    start_stamp_ = stamp;
+    sum_ = observation;
+    sum_.Y() *= 0.;
+    sum_.R() *= 0.;
+  } else if (stamp < last_stamp_) {
+    return false;
+  } else {
+    double dt = core::durationToSecond(stamp - last_stamp_);
+    sum_.Y() += last_.Y() * dt;
+    sum_.R() += last_.R() * (dt * dt);
+    time_span_ += dt;
+  }
+
+  last_stamp_ = stamp;
+  last_ = observation;
+  ++number_of_samples_;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+bool LocalisationPreintegrator<Observation>::empty() const
+{
+  return number_of_samples_ == 0;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+size_t LocalisationPreintegrator<Observation>::get_number_of_samples() const
+{
+  return number_of_samples_;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+core::Duration LocalisationPreintegrator<Observation>::get_time_span() const
+{
+  return last_stamp_ - start_stamp_;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+core::Duration LocalisationPreintegrator<Observation>::get_stamp() const
+{
+  return start_stamp_;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+Observation LocalisationPreintegrator<Observation>::integrate()
+{
+  Observation observation = last_;
+  if (time_span_ > 0) {
+    observation.Y() = sum_.Y() / time_span_;
+    observation.R() = sum_.R() / (time_span_ * time_span_);
+  }
+
+  // last sample is held over the next interval
+  start_stamp_ = last_stamp_;
+  sum_.Y() *= 0.;
+  sum_.R() *= 0.;
+  time_span_ = 0;
+  number_of_samples_ = 0;
+  return observation;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Observation>
+void LocalisationPreintegrator<Observation>::reset()
+{
+  has_sample_ = false;
+  start_stamp_ = core::Duration::zero();
+  last_stamp_ = core::Duration::zero();
+  time_span_ = 0;
+  number_of_samples_ = 0;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PREINTEGRATOR_HPP_
@@ -0,0 +1,128 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PRIORITY_DISPATCHER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PRIORITY_DISPATCHER_HPP_
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_dispatcher_base.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Runs dispatched jobs on a dedicated thread, highest updater priority first and
+// in arrival order within a priority. Without overload the queue stays empty and
+// jobs run in arrival order. When the queue is full the oldest job of the lowest
+// priority is shed (or the incoming job when its priority is lower still), so
+// low priority high rate streams are decimated, keeping their freshest jobs,
+// while rare high priority fixes still get through. Jobs waiting longer than
+// maximal delay are counted as delayed. Counters of each updater are appended to
+// its updater interface report.
+class LocalisationPriorityDispatcher : public LocalisationDispatcherBase
+{
+public:
+  LocalisationPriorityDispatcher(
+    const size_t & maximal_queue_size,
+    const core::Duration & maximal_delay);
+
+  ~LocalisationPriorityDispatcher() override;
+
+  LocalisationPriorityDispatcher(const LocalisationPriorityDispatcher &) = delete;
+  LocalisationPriorityDispatcher & operator=(const LocalisationPriorityDispatcher &) = delete;
+
+  size_t register_updater(const std::string & updater_name, const int & priority) override;
+
+  void dispatch(const size_t & updater_id, const core::Duration & stamp, Job && job) override;
+
+  // runs next job in calling thread while dispatcher is not started, returns
+  // false if queue is empty, throws if dispatcher thread is running
+  bool process_next();
+
+  void start();
+
+  void stop();
+
+  size_t get_queue_size() const;
+
+  size_t get_number_of_shed_jobs(const size_t & updater_id) const;
+
+  size_t get_number_of_delayed_jobs(const size_t & updater_id) const;
+
+  core::DiagnosticReport get_report() const override;
+
+  void append_to_report(
+    const size_t & updater_id,
+    core::DiagnosticReport & report) const override;
+
+private:
+  struct Entry
+  {
+    size_t updater_id;
+    std::chrono::steady_clock::time_point arrival_time;
+    Job job;
+  };
+
+  struct Statistics
+  {
+    std::string updater_name;
+    int priority;
+    size_t number_of_processed_jobs;
+    size_t number_of_shed_jobs;
+    size_t number_of_delayed_jobs;
+    std::chrono::steady_clock::duration maximal_delay;
+  };
+
+  // pops next job, mutex must be held, returns false if queue is empty
+  bool pop_next_(Job & job);
+
+  void run_();
+
+private:
+  size_t maximal_queue_size_;
+  std::chrono::steady_clock::duration maximal_delay_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::map<int, std::deque<Entry>, std::greater<int>> queues_;
+  size_t queue_size_;
+  std::vector<Statistics> statistics_;
+
+  bool stop_;
+  std::thread thread_;
+};
+
+std::shared_ptr<LocalisationPriorityDispatcher> make_priority_dispatcher(
+  std::shared_ptr<rclcpp::Node> node);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_PRIORITY_DISPATCHER_HPP_
@@ -0,0 +1,315 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_RANGE_BATCH_UPDATER_INTERFACE_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_RANGE_BATCH_UPDATER_INTERFACE_HPP_
+
+// std
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_common_utils/qos.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface_base.hpp"
+#include "romea_localisation_utils/conversions/observation_range_conversions.hpp"
+#include "romea_localisation_utils/conversions/stamp_conversions.hpp"
+
+
+namespace romea
+{
+namespace ros2
+{
+
+// Gathers the range observations of a ranging cycle (one per anchor) and applies
+// them to the filter in a single step, stamped with the first range of the batch,
+// instead of one step per range. Ranges stamped within batch window of the first
+// one are gathered, a null window only gathers ranges with the same stamp. A batch
+// is processed when a range out of window arrives, when it is full or on
+// heartbeat, so the last cycle is not held when the anchor stream stops.
+// When an anchor table is loaded, responder positions are looked up by anchor id
+// (header frame_id) instead of being read from each message, ranges from
+// unknown anchors are skipped and counted. Updater, filter and anchor table can
+// be replaced while messages are processed (see
+// LocalisationUpdaterInterfaceCommon).
+template<typename Filter_, typename Updater_>
+class LocalisationRangeBatchUpdaterInterface : public LocalisationUpdaterInterfaceBase
+{
+public:
+  using Filter = Filter_;
+  using Updater = Updater_;
+  using Observation = typename Updater_::Observation;
+  using Msg = romea_localisation_msgs::msg::ObservationRangeStamped;
+
+public:
+  LocalisationRangeBatchUpdaterInterface(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & topic_name,
+    const size_t & maximal_batch_size,
+    const double & batch_window);
+
+  void process_message(typename Msg::ConstSharedPtr msg);
+
+  void flush();
+
+  void load_updater(std::unique_ptr<Updater> updater);
+
+  void load_anchors(std::shared_ptr<const RangeAnchorTable> anchors);
+
+  void register_filter(std::shared_ptr<Filter> filter);
+
+  // each range of a batch is recorded before the batch is processed
+  void register_recorder(
+    std::shared_ptr<LocalisationObservationRecorder> recorder,
+    const std::string & updater_name);
+
+  bool heartbeat_callback(const core::Duration & duration) override;
+
+  core::DiagnosticReport get_report() override;
+
+private:
+  void flush_();
+
+private:
+  std::shared_ptr<Filter> filter_;
+  std::shared_ptr<Updater> updater_;
+  std::shared_ptr<rclcpp::Subscription<Msg>> sub_;
+  std::shared_ptr<const RangeAnchorTable> anchors_;
+  std::shared_ptr<LocalisationObservationRecorder> recorder_;
+  uint16_t recorder_id_;
+
+  size_t maximal_batch_size_;
+  core::Duration batch_window_;
+  core::Duration batch_stamp_;
+  std::vector<Observation> batch_;
+  std::mutex mutex_;
+
+  std::atomic<size_t> number_of_unknown_anchor_ranges_;
+  rclcpp::Logger logger_;
+  rclcpp::Clock::SharedPtr clock_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::LocalisationRangeBatchUpdaterInterface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const size_t & maximal_batch_size,
+  const double & batch_window)
+: LocalisationUpdaterInterfaceBase(),
+  filter_(nullptr),
+  updater_(nullptr),
+  sub_(),
+  anchors_(nullptr),
+  recorder_(nullptr),
+  recorder_id_(0),
+  maximal_batch_size_(maximal_batch_size),
+  batch_window_(core::durationFromSecond(batch_window)),
+  batch_stamp_(),
+  batch_(),
+  mutex_(),
+  number_of_unknown_anchor_ranges_(0),
+  logger_(node->get_logger()),
+  clock_(node->get_clock())
+{
+  if (maximal_batch_size_ == 0) {
+    throw(std::runtime_error("Range batch updater requires a non null batch size"));
+  }
+  if (batch_window < 0) {
+    throw(std::runtime_error("Range batch updater requires a non negative batch window"));
+  }
+  batch_.reserve(maximal_batch_size_);
+
+  auto callback = std::bind(
+    &LocalisationRangeBatchUpdaterInterface::process_message,
+    this, std::placeholders::_1);
+
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  // a whole ranging cycle can arrive at once
+  sub_ = node->create_subscription<Msg>(
+    topic_name, best_effort(maximal_batch_size_), callback, options);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::load_updater(
+  std::unique_ptr<Updater> updater)
+{
+  std::atomic_store(&updater_, std::shared_ptr<Updater>(std::move(updater)));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::load_anchors(
+  std::shared_ptr<const RangeAnchorTable> anchors)
+{
+  std::atomic_store(&anchors_, anchors);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::register_filter(
+  std::shared_ptr<Filter> filter)
+{
+  std::atomic_store(&filter_, filter);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::register_recorder(
+  std::shared_ptr<LocalisationObservationRecorder> recorder,
+  const std::string & updater_name)
+{
+  recorder_id_ = recorder->register_updater(updater_name);
+  recorder_ = recorder;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::process_message(
+  typename Msg::ConstSharedPtr msg)
+{
+  core::Duration duration = extract_stamp(*msg);
+
+  std::shared_ptr<const RangeAnchorTable> anchors = std::atomic_load(&anchors_);
+
+  Observation observation;
+  if (!anchors) {
+    extract_obs(*msg, observation);
+  } else if (!extract_obs(*msg, *anchors, observation)) {
+    ++number_of_unknown_anchor_ranges_;
+    RCLCPP_WARN_THROTTLE(
+      logger_, *clock_, 1000, "Range from unknown anchor %s is skipped",
+      msg->header.frame_id.c_str());
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // late ranges are not merged into a batch stamped after them
+  if (!batch_.empty() &&
+    (duration < batch_stamp_ || duration - batch_stamp_ > batch_window_))
+  {
+    flush_();
+  }
+
+  if (batch_.empty()) {
+    batch_stamp_ = duration;
+  }
+  batch_.push_back(std::move(observation));
+
+  if (batch_.size() == maximal_batch_size_) {
+    flush_();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  flush_();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+void LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::flush_()
+{
+  if (batch_.empty()) {
+    return;
+  }
+
+  // filter keeps update functions to replay them on out of order observations,
+  // so the batch is moved into the update function
+  std::vector<Observation> observations;
+  observations.reserve(maximal_batch_size_);
+  observations.swap(batch_);
+
+  // both instances are kept alive until update is done, even if swapped meanwhile
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  std::shared_ptr<Filter> filter = std::atomic_load(&filter_);
+  if (!updater || !filter) {
+    return;
+  }
+
+  if (recorder_) {
+    for (const auto & observation : observations) {
+      recorder_->record(recorder_id_, batch_stamp_, observation);
+    }
+  }
+
+  auto updateFunction =
+    [updater = std::move(updater), observations = std::move(observations)](
+    const core::Duration & duration, auto && ... args)
+    {
+      for (const auto & observation : observations) {
+        updater->update(duration, observation, args ...);
+      }
+    };
+
+  filter->process(batch_stamp_, std::move(updateFunction));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+bool LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::heartbeat_callback(
+  const core::Duration & duration)
+{
+  flush();
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  return !updater || updater->heartBeatCallback(duration);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_>
+core::DiagnosticReport LocalisationRangeBatchUpdaterInterface<Filter_, Updater_>::get_report()
+{
+  core::DiagnosticReport report;
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  if (updater) {
+    report = updater->getReport();
+  }
+
+  report.info["unknown_anchor_ranges"] = std::to_string(number_of_unknown_anchor_ranges_.load());
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+template<typename UpdaterInterface>
+std::unique_ptr<UpdaterInterface> make_range_batch_updater_interface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const size_t & maximal_batch_size,
+  const double & batch_window,
+  std::shared_ptr<typename UpdaterInterface::Filter> filter,
+  std::unique_ptr<typename UpdaterInterface::Updater> updater)
+{
+  auto interface = std::make_unique<UpdaterInterface>(
+    node, topic_name, maximal_batch_size, batch_window);
+  interface->load_updater(std::move(updater));
+  interface->register_filter(filter);
+  return interface;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_RANGE_BATCH_UPDATER_INTERFACE_HPP_
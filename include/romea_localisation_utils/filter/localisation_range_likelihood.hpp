@@ -0,0 +1,103 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_RANGE_LIKELIHOOD_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_RANGE_LIKELIHOOD_HPP_
+
+// std
+#include <vector>
+
+// eigen
+#include "Eigen/Core"
+
+// romea
+#include "romea_core_localisation/ObservationRange.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Range likelihood of a structure-of-arrays particle set (one array per state
+// component, as stored in row major particle matrices). Initiator antenna is
+// expressed in body frame and responder antenna in world frame. Particle
+// headings are turned into cosine/sine once per particle set so that several
+// ranges (anchors) can be evaluated without recomputing them. On x86 the AVX2
+// kernel is selected at runtime when the CPU supports it, NEON is used on aarch64.
+// No updater calls this kernel yet, core particle updaters weight particles
+// themselves. Its gain over evaluate_scalar depends on the CPU and particle set
+// size and has to be measured before an updater is switched to it.
+class LocalisationRangeLikelihood
+{
+public:
+  LocalisationRangeLikelihood();
+
+  void set_particles(
+    const double * x,
+    const double * y,
+    const double * yaw,
+    const size_t & number_of_particles);
+
+  size_t get_number_of_particles() const;
+
+  // likelihoods[n] = exp(-0.5 * (range - predicted_range[n])^2 / range_variance)
+  void evaluate(
+    const core::ObservationRange & observation,
+    double * likelihoods) const;
+
+  // weights[n] *= likelihood[n] for particles in [begin, end), so that batches
+  // can be shared over a thread pool
+  void weight(
+    const core::ObservationRange & observation,
+    double * weights,
+    const size_t & begin,
+    const size_t & end) const;
+
+  void weight(
+    const core::ObservationRange & observation,
+    double * weights) const;
+
+  void evaluate_scalar(
+    const core::ObservationRange & observation,
+    double * likelihoods) const;
+
+  static const char * simd_instruction_set();
+
+private:
+  template<bool Weighting>
+  void evaluate_(
+    const core::ObservationRange & observation,
+    const size_t & begin,
+    const size_t & end,
+    double * output) const;
+
+  template<bool Weighting>
+  void evaluate_scalar_(
+    const core::ObservationRange & observation,
+    const size_t & begin,
+    const size_t & end,
+    double * output) const;
+
+private:
+  const double * x_;
+  const double * y_;
+  std::vector<double, Eigen::aligned_allocator<double>> cos_yaw_;
+  std::vector<double, Eigen::aligned_allocator<double>> sin_yaw_;
+  size_t number_of_particles_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_RANGE_LIKELIHOOD_HPP_
@@ -0,0 +1,104 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_SEQUENCER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_SEQUENCER_HPP_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_dispatcher_base.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Dispatcher making the order of filter steps independent of thread scheduling.
+// Each job gets a global sequence number and jobs are run in (stamp, updater id,
+// sequence) order once every registered updater has received an observation at
+// least as recent (watermark), assuming that each updater receives its messages
+// in stamp order. Jobs older than the latest stamp minus the reorder window are
+// released anyway so that a silent updater cannot stall the filter, a null
+// window waits for all updaters. Jobs are run by the dispatching thread.
+class LocalisationSequencer : public LocalisationDispatcherBase
+{
+public:
+  explicit LocalisationSequencer(const core::Duration & reorder_window);
+
+  size_t register_updater(const std::string & updater_name, const int & priority) override;
+
+  void dispatch(const size_t & updater_id, const core::Duration & stamp, Job && job) override;
+
+  // runs all pending jobs, e.g. at the end of a replay
+  void flush();
+
+  size_t get_number_of_pending_jobs() const;
+
+  uint64_t get_number_of_dispatched_jobs() const;
+
+  size_t get_number_of_late_jobs() const;
+
+  core::DiagnosticReport get_report() const override;
+
+  void append_to_report(
+    const size_t & updater_id,
+    core::DiagnosticReport & report) const override;
+
+private:
+  struct Entry
+  {
+    int64_t stamp;
+    size_t updater_id;
+    uint64_t sequence;
+    mutable Job job;
+
+    bool operator>(const Entry & other) const;
+  };
+
+  void release_(const int64_t & watermark);
+
+  void run_(const int64_t & stamp, const Job & job);
+
+private:
+  int64_t reorder_window_;
+
+  mutable std::mutex mutex_;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pending_jobs_;
+  std::vector<std::string> updater_names_;
+  std::vector<int64_t> latest_stamps_;
+  std::vector<bool> has_stamps_;
+  std::vector<size_t> numbers_of_late_jobs_;
+  int64_t latest_stamp_;
+  int64_t last_released_stamp_;
+  bool has_released_;
+  uint64_t sequence_;
+  size_t number_of_late_jobs_;
+};
+
+std::shared_ptr<LocalisationSequencer> make_sequencer(std::shared_ptr<rclcpp::Node> node);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_SEQUENCER_HPP_
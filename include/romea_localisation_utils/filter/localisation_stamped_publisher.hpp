@@ -0,0 +1,118 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STAMPED_PUBLISHER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STAMPED_PUBLISHER_HPP_
+
+// std
+#include <memory>
+#include <string>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_utils/conversions/observation_conversions.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Publishes stamped messages through one preallocated message whose header
+// frame_id is set at construction. Only stamp and data fields are written
+// before each publication by the to_ros_msg overloads taking a stamp without
+// frame_id, which leave header frame_id untouched, so frame_id string and
+// message buffers are not reallocated in steady state. Publication
+// is done by const reference, intra process subscribers still receive a copy.
+// Middleware loans are only granted for plain message types and stamped messages
+// are never plain, their header holds a frame_id string. Fixed size observation
+// payloads are published through loans by LocalisationLoanedPublisher instead.
+// Not thread safe, data must be published from a single callback group.
+template<typename Msg>
+class LocalisationStampedPublisher
+{
+public:
+  using Message = Msg;
+
+public:
+  LocalisationStampedPublisher(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & topic_name,
+    const std::string & frame_id,
+    const rclcpp::QoS & qos);
+
+  template<typename Data>
+  void publish(const rclcpp::Time & stamp, const Data & data);
+
+  const std::string & get_frame_id() const;
+
+  size_t get_subscription_count() const;
+
+private:
+  std::shared_ptr<rclcpp::Publisher<Msg>> pub_;
+  Msg msg_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+LocalisationStampedPublisher<Msg>::LocalisationStampedPublisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const std::string & frame_id,
+  const rclcpp::QoS & qos)
+: pub_(node->create_publisher<Msg>(topic_name, qos)),
+  msg_()
+{
+  msg_.header.frame_id = frame_id;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+template<typename Data>
+void LocalisationStampedPublisher<Msg>::publish(const rclcpp::Time & stamp, const Data & data)
+{
+  to_ros_msg(stamp, data, msg_);
+  pub_->publish(msg_);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+const std::string & LocalisationStampedPublisher<Msg>::get_frame_id() const
+{
+  return msg_.header.frame_id;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+size_t LocalisationStampedPublisher<Msg>::get_subscription_count() const
+{
+  return pub_->get_subscription_count();
+}
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+std::unique_ptr<LocalisationStampedPublisher<Msg>> make_stamped_publisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const std::string & frame_id,
+  const rclcpp::QoS & qos)
+{
+  return std::make_unique<LocalisationStampedPublisher<Msg>>(node, topic_name, frame_id, qos);
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STAMPED_PUBLISHER_HPP_
@@ -0,0 +1,77 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATE_POOL_MONITOR_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATE_POOL_MONITOR_HPP_
+
+// std
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Mirrors the stamps of the states kept in the filter state pool in order to
+// report pool occupancy and observations whose rollback falls outside the pool.
+// As in the filter, the pool keeps the states with the most recent stamps.
+class LocalisationStatePoolMonitor
+{
+public:
+  explicit LocalisationStatePoolMonitor(const size_t & state_pool_size);
+
+  bool check(const core::Duration & stamp);
+
+  size_t get_state_pool_size() const;
+
+  core::Duration get_time_span() const;
+
+  core::Duration get_maximal_rollback_depth() const;
+
+  size_t get_number_of_rollbacks() const;
+
+  size_t get_number_of_out_of_pool_rollbacks() const;
+
+  core::DiagnosticReport get_report() const;
+
+private:
+  mutable std::mutex mutex_;
+  size_t state_pool_size_;
+  std::multiset<int64_t> stamps_;
+  int64_t latest_stamp_;
+  int64_t maximal_rollback_depth_;
+  size_t number_of_rollbacks_;
+  size_t number_of_out_of_pool_rollbacks_;
+};
+
+std::shared_ptr<LocalisationStatePoolMonitor> make_state_pool_monitor(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names = {});
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATE_POOL_MONITOR_HPP_
@@ -0,0 +1,65 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATUS_AGGREGATOR_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATUS_AGGREGATOR_HPP_
+
+// std
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_core_localisation/LocalisationFSMState.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Tracks the FSM states of several filters and reduces them to a single status,
+// the least healthy one: aborted if any filter is aborted, initialising if any
+// filter is not running yet, running otherwise.
+class LocalisationStatusAggregator
+{
+public:
+  LocalisationStatusAggregator();
+
+  size_t register_source(const std::string & source_name);
+
+  // returns true when aggregated status changes
+  bool update(const size_t & source_id, const core::LocalisationFSMState & fsm_state);
+
+  core::LocalisationFSMState get_status() const;
+
+  const std::string & get_source_name(const size_t & source_id) const;
+
+  size_t get_number_of_sources() const;
+
+  uint64_t get_number_of_transitions() const;
+
+private:
+  void aggregate_();
+
+private:
+  std::vector<std::string> source_names_;
+  std::vector<core::LocalisationFSMState> source_states_;
+  core::LocalisationFSMState status_;
+  uint64_t number_of_transitions_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATUS_AGGREGATOR_HPP_
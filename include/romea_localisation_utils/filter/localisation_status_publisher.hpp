@@ -0,0 +1,78 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATUS_PUBLISHER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATUS_PUBLISHER_HPP_
+
+// std
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_msgs/msg/localisation_status.hpp"
+#include "romea_localisation_utils/filter/localisation_status_aggregator.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Publishes localisation status when it changes instead of every filter cycle.
+// Status is republished after keepalive period without transition, so that late
+// subscribers and monitoring tools still see it. Status of several filters is
+// aggregated into one message (see LocalisationStatusAggregator).
+class LocalisationStatusPublisher
+{
+public:
+  using Message = romea_localisation_msgs::msg::LocalisationStatus;
+
+public:
+  LocalisationStatusPublisher(
+    std::shared_ptr<rclcpp::Node> node,
+    const std::string & topic_name,
+    const double & keepalive_period);
+
+  size_t register_source(const std::string & source_name);
+
+  // can be called every filter cycle, message is only published on transition
+  void update(const size_t & source_id, const core::LocalisationFSMState & fsm_state);
+
+  uint64_t get_number_of_publications() const;
+
+private:
+  void publish_();
+
+  void timer_callback_();
+
+private:
+  std::shared_ptr<rclcpp::Publisher<Message>> pub_;
+  std::shared_ptr<rclcpp::TimerBase> timer_;
+  LocalisationStatusAggregator aggregator_;
+  Message msg_;
+  uint64_t number_of_publications_;
+  mutable std::mutex mutex_;
+};
+
+std::unique_ptr<LocalisationStatusPublisher> make_status_publisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_STATUS_PUBLISHER_HPP_
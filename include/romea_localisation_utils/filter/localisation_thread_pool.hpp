@@ -0,0 +1,89 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_THREAD_POOL_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_THREAD_POOL_HPP_
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Fixed size pool used to split independent batches (e.g. observation log
+// decoding) over several cores. The calling thread takes part in the work, so a
+// pool of one thread runs everything inline. When a task throws, remaining
+// batches are skipped and the first exception is rethrown by parallel_for.
+class LocalisationThreadPool
+{
+public:
+  using Task = std::function<void (size_t begin, size_t end)>;
+
+public:
+  explicit LocalisationThreadPool(const size_t & number_of_threads);
+
+  ~LocalisationThreadPool();
+
+  LocalisationThreadPool(const LocalisationThreadPool &) = delete;
+  LocalisationThreadPool & operator=(const LocalisationThreadPool &) = delete;
+
+  size_t get_number_of_threads() const;
+
+  void parallel_for(const size_t & size, const Task & task, const size_t & minimal_batch_size = 64);
+
+private:
+  void worker_loop_();
+
+  void run_batches_();
+
+private:
+  std::vector<std::thread> workers_;
+
+  std::mutex job_mutex_;
+  std::mutex mutex_;
+  std::condition_variable job_condition_;
+  std::condition_variable done_condition_;
+  bool stop_;
+  uint64_t job_generation_;
+  size_t number_of_active_workers_;
+
+  const Task * task_;
+  std::exception_ptr error_;
+  size_t size_;
+  size_t batch_size_;
+  size_t number_of_batches_;
+  std::atomic<size_t> next_batch_;
+  std::atomic<size_t> number_of_done_batches_;
+  std::atomic<bool> has_error_;
+};
+
+std::shared_ptr<LocalisationThreadPool> make_thread_pool(std::shared_ptr<rclcpp::Node> node);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_THREAD_POOL_HPP_
@@ -16,6 +16,7 @@
 #define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_INTERFACE_HPP_
 
 // std
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -23,8 +24,7 @@
 // romea
 #include "romea_common_utils/qos.hpp"
 #include "romea_localisation_utils/filter/localisation_parameters.hpp"
-#include "romea_localisation_utils/filter/localisation_updater_interface_base.hpp"
-#include "romea_localisation_utils/conversions/observation_conversions.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface_common.hpp"
 
 
 namespace romea
@@ -32,8 +32,11 @@ namespace romea
 namespace ros2
 {
 
+// Updater interface subscribing to its topic at construction, messages are
+// processed as described in LocalisationUpdaterInterfaceCommon.
 template<typename Filter_, typename Updater_, typename Msg>
-class LocalisationUpdaterInterface : public LocalisationUpdaterInterfaceBase
+class LocalisationUpdaterInterface
+  : public LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>
 {
 public:
   using Filter = Filter_;
@@ -41,23 +44,18 @@ public:
   using Observation = typename Updater_::Observation;
 
 public:
+  // subscription is created in given callback group if any, e.g. in a group not
+  // handled by an executor when messages are taken by a wait set runtime
   LocalisationUpdaterInterface(
     std::shared_ptr<rclcpp::Node> node,
-    const std::string & topic_name);
+    const std::string & topic_name,
+    rclcpp::CallbackGroup::SharedPtr callback_group = nullptr);
 
   void process_message(typename Msg::ConstSharedPtr msg);
 
-  void load_updater(std::unique_ptr<Updater> updater);
-
-  void register_filter(std::shared_ptr<Filter> filter);
-
-  bool heartbeat_callback(const core::Duration & duration) override;
-
-  core::DiagnosticReport get_report() override;
+  std::shared_ptr<rclcpp::Subscription<Msg>> get_subscription() const;
 
 private:
-  std::shared_ptr<Filter> filter_;
-  std::unique_ptr<Updater> updater_;
   std::shared_ptr<rclcpp::Subscription<Msg>> sub_;
 };
 
@@ -65,10 +63,12 @@ private:
 template<typename Filter_, typename Updater_, typename Msg>
 LocalisationUpdaterInterface<Filter_, Updater_, Msg>::LocalisationUpdaterInterface(
   std::shared_ptr<rclcpp::Node> node,
-  const std::string & topic_name)
-: LocalisationUpdaterInterfaceBase(),
-  filter_(nullptr),
-  updater_(nullptr),
+  const std::string & topic_name,
+  rclcpp::CallbackGroup::SharedPtr callback_group)
+: LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>(
+    node->get_node_topics_interface()->resolve_topic_name(topic_name),
+    node->get_logger(),
+    node->get_clock()),
   sub_()
 {
   auto callback = std::bind(
@@ -76,29 +76,18 @@ LocalisationUpdaterInterface<Filter_, Updater_, Msg>::LocalisationUpdaterInterfa
     this, std::placeholders::_1);
 
   rclcpp::SubscriptionOptions options;
-  options.callback_group = node->create_callback_group(
+  options.callback_group = callback_group ? callback_group : node->create_callback_group(
     rclcpp::CallbackGroupType::MutuallyExclusive);
 
-  // callback_group_ = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
-
   sub_ = node->create_subscription<Msg>(topic_name, best_effort(1), callback, options);
 }
 
-
-//-----------------------------------------------------------------------------
-template<typename Filter_, typename Updater_, typename Msg>
-void LocalisationUpdaterInterface<Filter_, Updater_, Msg>::load_updater(
-  std::unique_ptr<Updater> updater)
-{
-  updater_.swap(updater);
-}
-
 //-----------------------------------------------------------------------------
 template<typename Filter_, typename Updater_, typename Msg>
-void LocalisationUpdaterInterface<Filter_, Updater_, Msg>::register_filter(
-  std::shared_ptr<Filter> filter)
+std::shared_ptr<rclcpp::Subscription<Msg>>
+LocalisationUpdaterInterface<Filter_, Updater_, Msg>::get_subscription() const
 {
-  filter_ = filter;
+  return sub_;
 }
 
 //-----------------------------------------------------------------------------
@@ -106,34 +95,21 @@ template<class Filter_, class Updater_, class Msg>
 void LocalisationUpdaterInterface<Filter_, Updater_, Msg>::process_message(
   typename Msg::ConstSharedPtr msg)
 {
-  core::Duration duration = extract_duration(*msg);
-
-  Observation observation = extract_obs<Observation>(*msg);
-
-  auto updateFunction = std::bind(
-    &Updater::update,
-    updater_.get(),
-    std::placeholders::_1,
-    std::move(observation),
-    std::placeholders::_2,
-    std::placeholders::_3);
-
-  filter_->process(duration, std::move(updateFunction));
-}
-
-//-----------------------------------------------------------------------------
-template<class Filter_, class Updater_, class Msg>
-bool LocalisationUpdaterInterface<Filter_, Updater_, Msg>::heartbeat_callback(
-  const core::Duration & duration)
-{
-  return updater_->heartBeatCallback(duration);
+  this->process_(*msg);
 }
 
 //-----------------------------------------------------------------------------
-template<class Filter_, class Updater_, class Msg>
-core::DiagnosticReport LocalisationUpdaterInterface<Filter_, Updater_, Msg>::get_report()
+template<typename UpdaterInterface>
+std::unique_ptr<UpdaterInterface> make_updater_interface(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  std::shared_ptr<typename UpdaterInterface::Filter> filter,
+  std::unique_ptr<typename UpdaterInterface::Updater> updater)
 {
-  return updater_->getReport();
+  auto interface = std::make_unique<UpdaterInterface>(node, topic_name);
+  interface->load_updater(std::move(updater));
+  interface->register_filter(filter);
+  return interface;
 }
 
 //-----------------------------------------------------------------------------
@@ -142,9 +118,10 @@ std::unique_ptr<UpdaterInterface> make_updater_interface(
   std::shared_ptr<rclcpp::Node> node,
   const std::string & topic_name,
   std::shared_ptr<typename UpdaterInterface::Filter> filter,
-  std::unique_ptr<typename UpdaterInterface::Updater> updater)
+  std::unique_ptr<typename UpdaterInterface::Updater> updater,
+  rclcpp::CallbackGroup::SharedPtr callback_group)
 {
-  auto interface = std::make_unique<UpdaterInterface>(node, topic_name);
+  auto interface = std::make_unique<UpdaterInterface>(node, topic_name, callback_group);
   interface->load_updater(std::move(updater));
   interface->register_filter(filter);
   return interface;
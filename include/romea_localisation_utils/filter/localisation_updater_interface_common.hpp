@@ -0,0 +1,317 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_INTERFACE_COMMON_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_INTERFACE_COMMON_HPP_
+
+// std
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_dispatcher_base.hpp"
+#include "romea_localisation_utils/filter/localisation_load_controller.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+#include "romea_localisation_utils/filter/localisation_state_pool_monitor.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface_base.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_statistics.hpp"
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
+#include "romea_localisation_utils/conversions/observation_conversions.hpp"
+
+
+namespace romea
+{
+namespace ros2
+{
+
+// Message processing shared by single topic updater interfaces, whatever the
+// way their subscription is managed (see LocalisationUpdaterInterface and
+// LocalisationLifecycleUpdaterInterface). Updater and filter can be replaced
+// while messages are processed: they are swapped atomically (RCU style), updates
+// in flight keep a reference to the instances they started with while new
+// messages use the new ones. Messages are ignored while none is loaded.
+template<typename Filter_, typename Updater_, typename Msg>
+class LocalisationUpdaterInterfaceCommon : public LocalisationUpdaterInterfaceBase
+{
+public:
+  using Filter = Filter_;
+  using Updater = Updater_;
+  using Observation = typename Updater_::Observation;
+
+public:
+  LocalisationUpdaterInterfaceCommon(
+    const std::string & topic_name,
+    const rclcpp::Logger & logger,
+    rclcpp::Clock::SharedPtr clock);
+
+  void load_updater(std::unique_ptr<Updater> updater);
+
+  void register_filter(std::shared_ptr<Filter> filter);
+
+  void register_state_pool_monitor(std::shared_ptr<LocalisationStatePoolMonitor> monitor);
+
+  // updates are handed to dispatcher instead of being processed in subscription callback
+  void register_dispatcher(
+    std::shared_ptr<LocalisationDispatcherBase> dispatcher,
+    const std::string & updater_name,
+    const int & priority);
+
+  // messages are decimated when filter steps exceed load controller CPU budget
+  void register_load_controller(
+    std::shared_ptr<LocalisationLoadController> load_controller,
+    const std::string & updater_name,
+    const unsigned int & minimal_rate);
+
+  // extracted observations are recorded in binary log before being processed
+  void register_recorder(
+    std::shared_ptr<LocalisationObservationRecorder> recorder,
+    const std::string & updater_name);
+
+  // lever arms of pose, position and twist observations are resolved from
+  // message frame_id instead of being read from message
+  void register_lever_arms(std::shared_ptr<const LeverArmRegistry> lever_arms);
+
+  // called before each update, e.g. to flush preintegrated proprioceptive observations
+  void register_flush_callback(std::function<void()> callback);
+
+  bool heartbeat_callback(const core::Duration & duration) override;
+
+  core::DiagnosticReport get_report() override;
+
+protected:
+  void process_(const Msg & msg);
+
+private:
+  std::string topic_name_;
+  std::shared_ptr<Filter> filter_;
+  std::shared_ptr<Updater> updater_;
+  std::shared_ptr<LocalisationStatePoolMonitor> state_pool_monitor_;
+  std::function<void()> flush_callback_;
+  std::shared_ptr<LocalisationDispatcherBase> dispatcher_;
+  size_t dispatcher_id_;
+  std::shared_ptr<LocalisationLoadController> load_controller_;
+  size_t load_controller_id_;
+  std::shared_ptr<LocalisationObservationRecorder> recorder_;
+  uint16_t recorder_id_;
+  std::shared_ptr<const LeverArmRegistry> lever_arms_;
+  LocalisationUpdaterStatistics statistics_;
+  rclcpp::Logger logger_;
+  rclcpp::Clock::SharedPtr clock_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::LocalisationUpdaterInterfaceCommon(
+  const std::string & topic_name,
+  const rclcpp::Logger & logger,
+  rclcpp::Clock::SharedPtr clock)
+: LocalisationUpdaterInterfaceBase(),
+  topic_name_(topic_name),
+  filter_(nullptr),
+  updater_(nullptr),
+  state_pool_monitor_(nullptr),
+  flush_callback_(),
+  dispatcher_(nullptr),
+  dispatcher_id_(0),
+  load_controller_(nullptr),
+  load_controller_id_(0),
+  recorder_(nullptr),
+  recorder_id_(0),
+  lever_arms_(nullptr),
+  statistics_(),
+  logger_(logger),
+  clock_(clock)
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::load_updater(
+  std::unique_ptr<Updater> updater)
+{
+  std::atomic_store(&updater_, std::shared_ptr<Updater>(std::move(updater)));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_filter(
+  std::shared_ptr<Filter> filter)
+{
+  std::atomic_store(&filter_, filter);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_state_pool_monitor(
+  std::shared_ptr<LocalisationStatePoolMonitor> monitor)
+{
+  state_pool_monitor_ = monitor;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_dispatcher(
+  std::shared_ptr<LocalisationDispatcherBase> dispatcher,
+  const std::string & updater_name,
+  const int & priority)
+{
+  dispatcher_id_ = dispatcher->register_updater(updater_name, priority);
+  dispatcher_ = dispatcher;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_load_controller(
+  std::shared_ptr<LocalisationLoadController> load_controller,
+  const std::string & updater_name,
+  const unsigned int & minimal_rate)
+{
+  load_controller_id_ = load_controller->register_updater(updater_name, minimal_rate);
+  load_controller_ = load_controller;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_recorder(
+  std::shared_ptr<LocalisationObservationRecorder> recorder,
+  const std::string & updater_name)
+{
+  recorder_id_ = recorder->register_updater(updater_name);
+  recorder_ = recorder;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_lever_arms(
+  std::shared_ptr<const LeverArmRegistry> lever_arms)
+{
+  lever_arms_ = lever_arms;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Filter_, typename Updater_, typename Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::register_flush_callback(
+  std::function<void()> callback)
+{
+  flush_callback_ = callback;
+}
+
+//-----------------------------------------------------------------------------
+template<class Filter_, class Updater_, class Msg>
+void LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::process_(const Msg & msg)
+{
+  // both instances are kept alive until update is done, even if swapped meanwhile
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  std::shared_ptr<Filter> filter = std::atomic_load(&filter_);
+  if (!updater || !filter) {
+    return;
+  }
+
+  core::Duration duration = extract_stamp(msg);
+  statistics_.update(duration, core::Duration(clock_->now().nanoseconds()));
+
+  if (load_controller_ && !load_controller_->accept(load_controller_id_)) {
+    return;
+  }
+
+  if (state_pool_monitor_ && !state_pool_monitor_->check(duration)) {
+    RCLCPP_WARN_THROTTLE(
+      logger_, *clock_, 1000,
+      "Observation from %s is older than the filter state pool, "
+      "increase filter.state_pool_size or filter.maximal_observation_latency",
+      topic_name_.c_str());
+  }
+
+  Observation observation;
+  if constexpr (detail::has_level_arm<Observation>::value) {
+    if (lever_arms_) {
+      extract_obs(msg, *lever_arms_, observation);
+    } else {
+      extract_obs(msg, observation);
+    }
+  } else {
+    extract_obs(msg, observation);
+  }
+
+  if (recorder_) {
+    recorder_->record(recorder_id_, duration, observation);
+  }
+
+  auto updateFunction = std::bind(
+    &Updater::update,
+    std::move(updater),
+    std::placeholders::_1,
+    std::move(observation),
+    std::placeholders::_2,
+    std::placeholders::_3);
+
+  if (flush_callback_) {
+    flush_callback_();
+  }
+
+  auto process =
+    [filter = std::move(filter), load_controller = load_controller_.get(),
+    load_controller_id = load_controller_id_, duration,
+    updateFunction = std::move(updateFunction)]() mutable
+    {
+      auto start = LocalisationLoadController::Clock::now();
+      filter->process(duration, std::move(updateFunction));
+      if (load_controller) {
+        load_controller->record(
+          load_controller_id, LocalisationLoadController::Clock::now() - start);
+      }
+    };
+
+  if (dispatcher_) {
+    dispatcher_->dispatch(dispatcher_id_, duration, std::move(process));
+  } else {
+    process();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<class Filter_, class Updater_, class Msg>
+bool LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::heartbeat_callback(
+  const core::Duration & duration)
+{
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  return !updater || updater->heartBeatCallback(duration);
+}
+
+//-----------------------------------------------------------------------------
+template<class Filter_, class Updater_, class Msg>
+core::DiagnosticReport LocalisationUpdaterInterfaceCommon<Filter_, Updater_, Msg>::get_report()
+{
+  core::DiagnosticReport report;
+  std::shared_ptr<Updater> updater = std::atomic_load(&updater_);
+  if (updater) {
+    report = updater->getReport();
+  }
+
+  statistics_.append_to_report(report);
+  if (dispatcher_) {
+    dispatcher_->append_to_report(dispatcher_id_, report);
+  }
+  return report;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_INTERFACE_COMMON_HPP_
@@ -0,0 +1,75 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_STATISTICS_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_STATISTICS_HPP_
+
+// std
+#include <cstdint>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
+#include "romea_localisation_utils/filter/seqlock.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Rolling statistics of the messages received by an updater: arrival rate,
+// inter-arrival jitter (standard deviation), stamp to arrival delay and bursts
+// (messages arriving within a quarter of the mean period of the previous one)
+// and messages stamped before the latest stamp already received.
+// Statistics are updated by the subscription callback and published through a
+// seqlock, so reading them for diagnostics never blocks message processing.
+class LocalisationUpdaterStatistics
+{
+public:
+  struct Snapshot
+  {
+    uint64_t number_of_messages;
+    double rate;
+    double jitter;
+    double mean_delay;
+    double maximal_delay;
+    uint64_t number_of_bursts;
+    uint64_t maximal_burst_size;
+    uint64_t number_of_out_of_order_messages;
+  };
+
+public:
+  LocalisationUpdaterStatistics();
+
+  // must not be called concurrently
+  void update(const core::Duration & stamp, const core::Duration & arrival_time);
+
+  Snapshot get_snapshot() const;
+
+  void append_to_report(core::DiagnosticReport & report) const;
+
+private:
+  Snapshot snapshot_;
+  int64_t last_arrival_time_;
+  int64_t last_stamp_;
+  double mean_period_;
+  double period_variance_;
+  uint64_t burst_size_;
+  Seqlock<Snapshot> published_snapshot_;
+};
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_UPDATER_STATISTICS_HPP_
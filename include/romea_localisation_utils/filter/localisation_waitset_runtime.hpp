@@ -0,0 +1,156 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_WAITSET_RUNTIME_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_WAITSET_RUNTIME_HPP_
+
+// std
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ros
+#include "rclcpp/rclcpp.hpp"
+
+// romea
+#include "romea_localisation_utils/conversions/stamp_conversions.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+// Executor free runtime for updater interfaces: subscriptions are created in a
+// callback group that is not added to any executor, waited on with a wait set
+// and their messages are taken manually. All messages ready after a wait are
+// processed in stamp order on a single thread, optionally pinned to a CPU.
+// Subscriptions must be created in the runtime callback group (see
+// get_callback_group()) and added before start.
+class LocalisationWaitSetRuntime
+{
+public:
+  LocalisationWaitSetRuntime(
+    std::shared_ptr<rclcpp::Node> node,
+    const int & cpu,
+    const std::chrono::nanoseconds & wait_timeout);
+
+  ~LocalisationWaitSetRuntime();
+
+  LocalisationWaitSetRuntime(const LocalisationWaitSetRuntime &) = delete;
+  LocalisationWaitSetRuntime & operator=(const LocalisationWaitSetRuntime &) = delete;
+
+  rclcpp::CallbackGroup::SharedPtr get_callback_group() const;
+
+  template<typename Msg>
+  void add_subscription(
+    std::shared_ptr<rclcpp::Subscription<Msg>> subscription,
+    std::function<void(std::shared_ptr<const Msg>)> callback);
+
+  template<typename UpdaterInterface>
+  void add_updater_interface(UpdaterInterface & interface);
+
+  // waits once and processes ready messages in calling thread
+  void spin_some();
+
+  void start();
+
+  void stop();
+
+private:
+  struct Sample
+  {
+    core::Duration stamp;
+    std::function<void()> process;
+  };
+
+  using Taker = std::function<void (std::vector<Sample> &)>;
+
+  void run_();
+
+  void pin_thread_();
+
+private:
+  rclcpp::Logger logger_;
+  rclcpp::Context::SharedPtr context_;
+  rclcpp::CallbackGroup::SharedPtr callback_group_;
+  rclcpp::WaitSet wait_set_;
+  std::vector<Taker> takers_;
+  std::vector<Sample> samples_;
+
+  int cpu_;
+  std::chrono::nanoseconds wait_timeout_;
+  std::atomic<bool> stop_;
+  std::thread thread_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename Msg>
+void LocalisationWaitSetRuntime::add_subscription(
+  std::shared_ptr<rclcpp::Subscription<Msg>> subscription,
+  std::function<void(std::shared_ptr<const Msg>)> callback)
+{
+  if (thread_.joinable()) {
+    throw(std::runtime_error("Subscriptions cannot be added to a running wait set runtime"));
+  }
+
+  // a subscription in an executor callback group would also be taken by executor
+  auto is_same = [&subscription](const rclcpp::SubscriptionBase::SharedPtr & candidate) {
+      return candidate == subscription;
+    };
+
+  if (!callback_group_->find_subscription_ptrs_if(is_same)) {
+    throw(std::runtime_error(
+        "Subscription to " + std::string(subscription->get_topic_name()) +
+        " is not in wait set runtime callback group"));
+  }
+
+  wait_set_.add_subscription(subscription);
+
+  takers_.push_back(
+    [subscription, callback](std::vector<Sample> & samples)
+    {
+      rclcpp::MessageInfo info;
+      auto msg = std::make_shared<Msg>();
+      while (subscription->take(*msg, info)) {
+        samples.push_back({extract_stamp(*msg), [callback, msg]() {callback(msg);}});
+        msg = std::make_shared<Msg>();
+      }
+    });
+}
+
+//-----------------------------------------------------------------------------
+template<typename UpdaterInterface>
+void LocalisationWaitSetRuntime::add_updater_interface(UpdaterInterface & interface)
+{
+  auto subscription = interface.get_subscription();
+  using Msg = typename decltype(subscription)::element_type::MessageType;
+
+  add_subscription<Msg>(
+    subscription, [&interface](std::shared_ptr<const Msg> msg) {
+      interface.process_message(msg);
+    });
+}
+
+std::unique_ptr<LocalisationWaitSetRuntime> make_waitset_runtime(
+  std::shared_ptr<rclcpp::Node> node);
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__LOCALISATION_WAITSET_RUNTIME_HPP_
@@ -0,0 +1,116 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__SEQLOCK_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__SEQLOCK_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace romea
+{
+namespace ros2
+{
+
+// Sequence lock for small trivially copyable values: readers never block writers
+// and retry when they overlap a write.
+template<typename T>
+class Seqlock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Seqlock requires a trivially copyable type");
+
+public:
+  Seqlock();
+
+  explicit Seqlock(const T & value);
+
+  void store(const T & value);
+
+  T load() const;
+
+private:
+  static constexpr size_t NUMBER_OF_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  using Words = std::array<uint64_t, NUMBER_OF_WORDS>;
+
+  std::atomic<uint64_t> sequence_;
+  std::array<std::atomic<uint64_t>, NUMBER_OF_WORDS> words_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename T>
+Seqlock<T>::Seqlock()
+: Seqlock(T())
+{
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+Seqlock<T>::Seqlock(const T & value)
+: sequence_(0),
+  words_()
+{
+  store(value);
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void Seqlock<T>::store(const T & value)
+{
+  Words words{};
+  std::memcpy(words.data(), &value, sizeof(T));
+
+  uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  while ((sequence & 1) || !sequence_.compare_exchange_weak(
+      sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed))
+  {
+    sequence = sequence_.load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  for (size_t n = 0; n < NUMBER_OF_WORDS; ++n) {
+    words_[n].store(words[n], std::memory_order_relaxed);
+  }
+
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+T Seqlock<T>::load() const
+{
+  Words words;
+  uint64_t sequence_before;
+  uint64_t sequence_after;
+  do {
+    sequence_before = sequence_.load(std::memory_order_acquire);
+    for (size_t n = 0; n < NUMBER_OF_WORDS; ++n) {
+      words[n] = words_[n].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    sequence_after = sequence_.load(std::memory_order_relaxed);
+  } while ((sequence_before & 1) || sequence_before != sequence_after);
+
+  T value;
+  std::memcpy(&value, words.data(), sizeof(T));
+  return value;
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__SEQLOCK_HPP_
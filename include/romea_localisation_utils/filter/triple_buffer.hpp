@@ -0,0 +1,129 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROMEA_LOCALISATION_UTILS__FILTER__TRIPLE_BUFFER_HPP_
+#define ROMEA_LOCALISATION_UTILS__FILTER__TRIPLE_BUFFER_HPP_
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace romea
+{
+namespace ros2
+{
+
+// Wait-free single producer / single consumer publication of the latest value.
+// The producer fills write_buffer() then calls publish(), the consumer calls
+// read() and always gets the most recent published value without blocking
+// the producer. Values are preallocated once so that objects owning dynamic
+// memory (e.g. particle filter results) can be reused without reallocation.
+template<typename T>
+class TripleBuffer
+{
+public:
+  TripleBuffer(
+    std::unique_ptr<T> buffer0,
+    std::unique_ptr<T> buffer1,
+    std::unique_ptr<T> buffer2);
+
+  T & write_buffer();
+
+  void publish();
+
+  const T & read();
+
+  bool has_new_data() const;
+
+  uint64_t number_of_publications() const;
+
+private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t DIRTY_FLAG = 0x4;
+
+  std::array<std::unique_ptr<T>, 3> buffers_;
+  uint8_t write_index_;
+  uint8_t read_index_;
+  std::atomic<uint8_t> middle_index_;
+  std::atomic<uint64_t> number_of_publications_;
+};
+
+//-----------------------------------------------------------------------------
+template<typename T>
+TripleBuffer<T>::TripleBuffer(
+  std::unique_ptr<T> buffer0,
+  std::unique_ptr<T> buffer1,
+  std::unique_ptr<T> buffer2)
+: buffers_{std::move(buffer0), std::move(buffer1), std::move(buffer2)},
+  write_index_(0),
+  read_index_(1),
+  middle_index_(2),
+  number_of_publications_(0)
+{
+  for (const auto & buffer : buffers_) {
+    if (buffer == nullptr) {
+      throw(std::runtime_error("Triple buffer cannot be built from null buffers"));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+T & TripleBuffer<T>::write_buffer()
+{
+  return *buffers_[write_index_];
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void TripleBuffer<T>::publish()
+{
+  uint8_t previous = middle_index_.exchange(write_index_ | DIRTY_FLAG, std::memory_order_acq_rel);
+  write_index_ = previous & INDEX_MASK;
+  number_of_publications_.fetch_add(1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+const T & TripleBuffer<T>::read()
+{
+  if (middle_index_.load(std::memory_order_relaxed) & DIRTY_FLAG) {
+    uint8_t previous = middle_index_.exchange(read_index_, std::memory_order_acq_rel);
+    read_index_ = previous & INDEX_MASK;
+  }
+  return *buffers_[read_index_];
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+bool TripleBuffer<T>::has_new_data() const
+{
+  return middle_index_.load(std::memory_order_relaxed) & DIRTY_FLAG;
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+uint64_t TripleBuffer<T>::number_of_publications() const
+{
+  return number_of_publications_.load(std::memory_order_acquire);
+}
+
+}  // namespace ros2
+}  // namespace romea
+
+#endif  // ROMEA_LOCALISATION_UTILS__FILTER__TRIPLE_BUFFER_HPP_
@@ -0,0 +1,66 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <memory>
+#include <string>
+
+// romea
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LeverArmRegistry::LeverArmRegistry()
+: table_(std::make_shared<const Table>())
+{
+}
+
+//-----------------------------------------------------------------------------
+void LeverArmRegistry::set(const std::string & frame_id, const Eigen::Vector3d & lever_arm)
+{
+  // copy on write, retried if another calibration update was published meanwhile
+  std::shared_ptr<const Table> table = std::atomic_load(&table_);
+  std::shared_ptr<const Table> updated_table;
+  do {
+    auto copy = std::make_shared<Table>(*table);
+    (*copy)[frame_id] = lever_arm;
+    updated_table = std::move(copy);
+  } while (!std::atomic_compare_exchange_weak(&table_, &table, updated_table));
+}
+
+//-----------------------------------------------------------------------------
+bool LeverArmRegistry::find(const std::string & frame_id, Eigen::Vector3d & lever_arm) const
+{
+  std::shared_ptr<const Table> table = std::atomic_load(&table_);
+  auto it = table->find(frame_id);
+  if (it == table->end()) {
+    return false;
+  }
+
+  lever_arm = it->second;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t LeverArmRegistry::size() const
+{
+  return std::atomic_load(&table_)->size();
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -45,6 +45,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationAttitudeStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, observation, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationAttitude & observation,
+  romea_localisation_msgs::msg::ObservationAttitudeStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(observation, msg.observation_attitude);
 }
@@ -39,8 +39,17 @@ void to_ros_msg(
   const core::ObservationCourse & observation,
   romea_localisation_msgs::msg::ObservationCourseStamped & msg)
 {
-  msg.header.stamp = stamp;
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, observation, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationCourse & observation,
+  romea_localisation_msgs::msg::ObservationCourseStamped & msg)
+{
+  msg.header.stamp = stamp;
   to_ros_msg(observation, msg.observation_course);
 }
 
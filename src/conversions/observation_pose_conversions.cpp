@@ -42,6 +42,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationPose2DStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, pose, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::Pose2D & pose,
+  romea_localisation_msgs::msg::ObservationPose2DStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(pose, msg.observation_pose);
 }
@@ -71,6 +80,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationPose2DStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, observation, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationPose & observation,
+  romea_localisation_msgs::msg::ObservationPose2DStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(observation, msg.observation_pose);
 }
@@ -89,5 +107,24 @@ void extract_obs(
   observation.levelArm.z() = msg.observation_pose.level_arm.z;
 }
 
+//-----------------------------------------------------------------------------
+void extract_obs(
+  const romea_localisation_msgs::msg::ObservationPose2DStamped & msg,
+  const LeverArmRegistry & lever_arms,
+  core::ObservationPose & observation)
+{
+  observation.Y(core::ObservationPose::POSITION_X) = msg.observation_pose.pose.position.x;
+  observation.Y(core::ObservationPose::POSITION_Y) = msg.observation_pose.pose.position.y;
+  observation.Y(core::ObservationPose::ORIENTATION_Z) = msg.observation_pose.pose.yaw;
+  observation.R() = Eigen::Matrix3d(msg.observation_pose.pose.covariance.data());
+
+  // lever arm of message is only read if frame is not registered
+  if (!lever_arms.find(msg.header.frame_id, observation.levelArm)) {
+    observation.levelArm.x() = msg.observation_pose.level_arm.x;
+    observation.levelArm.y() = msg.observation_pose.level_arm.y;
+    observation.levelArm.z() = msg.observation_pose.level_arm.z;
+  }
+}
+
 }  // namespace ros2
 }  // namespace romea
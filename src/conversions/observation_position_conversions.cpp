@@ -42,6 +42,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationPosition2DStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, position, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::Position2D & position,
+  romea_localisation_msgs::msg::ObservationPosition2DStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(position, msg.observation_position);
 }
@@ -70,6 +79,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationPosition2DStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, observation, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationPosition & observation,
+  romea_localisation_msgs::msg::ObservationPosition2DStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(observation, msg.observation_position);
 }
@@ -87,5 +105,23 @@ void extract_obs(
   observation.levelArm.z() = msg.observation_position.level_arm.z;
 }
 
+//-----------------------------------------------------------------------------
+void extract_obs(
+  const romea_localisation_msgs::msg::ObservationPosition2DStamped & msg,
+  const LeverArmRegistry & lever_arms,
+  core::ObservationPosition & observation)
+{
+  observation.Y(core::ObservationPosition::POSITION_X) = msg.observation_position.position.x;
+  observation.Y(core::ObservationPosition::POSITION_Y) = msg.observation_position.position.y;
+  observation.R() = Eigen::Matrix2d(msg.observation_position.position.covariance.data());
+
+  // lever arm of message is only read if frame is not registered
+  if (!lever_arms.find(msg.header.frame_id, observation.levelArm)) {
+    observation.levelArm.x() = msg.observation_position.level_arm.x;
+    observation.levelArm.y() = msg.observation_position.level_arm.y;
+    observation.levelArm.z() = msg.observation_position.level_arm.z;
+  }
+}
+
 }  // namespace ros2
 }  // namespace romea
@@ -46,6 +46,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationRangeStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, observation, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationRange & observation,
+  romea_localisation_msgs::msg::ObservationRangeStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(observation, msg.observation_range);
 }
@@ -65,5 +74,26 @@ void extract_obs(
   observation.responderPosition.z() = msg.observation_range.responder_antenna_position.z;
 }
 
+//-----------------------------------------------------------------------------
+bool extract_obs(
+  const romea_localisation_msgs::msg::ObservationRangeStamped & msg,
+  const RangeAnchorTable & anchors,
+  core::ObservationRange & observation)
+{
+  size_t index = anchors.find(msg.header.frame_id);
+  if (index == RangeAnchorTable::NOT_FOUND) {
+    return false;
+  }
+
+  // responder antenna position of message is not read, anchor table is used
+  observation.Y() = msg.observation_range.range;
+  observation.R() = msg.observation_range.range_std * msg.observation_range.range_std;
+  observation.initiatorPosition.x() = msg.observation_range.initiator_antenna_position.x;
+  observation.initiatorPosition.y() = msg.observation_range.initiator_antenna_position.y;
+  observation.initiatorPosition.z() = msg.observation_range.initiator_antenna_position.z;
+  observation.responderPosition = anchors.get_position(index);
+  return true;
+}
+
 }  // namespace ros2
 }  // namespace romea
@@ -43,6 +43,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationTwist2DStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, twist, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::Twist2D & twist,
+  romea_localisation_msgs::msg::ObservationTwist2DStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(twist, msg.observation_twist);
 }
@@ -72,6 +81,15 @@ void to_ros_msg(
   romea_localisation_msgs::msg::ObservationTwist2DStamped & msg)
 {
   msg.header.frame_id = frame_id;
+  to_ros_msg(stamp, observation, msg);
+}
+
+//-----------------------------------------------------------------------------
+void to_ros_msg(
+  const rclcpp::Time & stamp,
+  const core::ObservationTwist & observation,
+  romea_localisation_msgs::msg::ObservationTwist2DStamped & msg)
+{
   msg.header.stamp = stamp;
   to_ros_msg(observation, msg.observation_twist);
 }
@@ -93,5 +111,27 @@ void extract_obs(
   observation.levelArm.z() = msg.observation_twist.level_arm.z;
 }
 
+//-----------------------------------------------------------------------------
+void extract_obs(
+  const romea_localisation_msgs::msg::ObservationTwist2DStamped & msg,
+  const LeverArmRegistry & lever_arms,
+  core::ObservationTwist & observation)
+{
+  observation.Y(core::ObservationTwist::LINEAR_SPEED_X_BODY) =
+    msg.observation_twist.twist.linear_speeds.x;
+  observation.Y(core::ObservationTwist::LINEAR_SPEED_Y_BODY) =
+    msg.observation_twist.twist.linear_speeds.y;
+  observation.Y(core::ObservationTwist::ANGULAR_SPEED_Z_BODY) =
+    msg.observation_twist.twist.angular_speed;
+  observation.R() = Eigen::Matrix3d(msg.observation_twist.twist.covariance.data());
+
+  // lever arm of message is only read if frame is not registered
+  if (!lever_arms.find(msg.header.frame_id, observation.levelArm)) {
+    observation.levelArm.x() = msg.observation_twist.level_arm.x;
+    observation.levelArm.y() = msg.observation_twist.level_arm.y;
+    observation.levelArm.z() = msg.observation_twist.level_arm.z;
+  }
+}
+
 }  // namespace ros2
 }  // namespace romea
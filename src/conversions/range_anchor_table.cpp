@@ -0,0 +1,109 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// romea
+#include "romea_localisation_utils/conversions/range_anchor_table.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+RangeAnchorTable::RangeAnchorTable()
+: positions_(),
+  indexes_()
+{
+}
+
+//-----------------------------------------------------------------------------
+void RangeAnchorTable::add(const std::string & anchor_id, const Eigen::Vector3d & position)
+{
+  auto it = indexes_.find(anchor_id);
+  if (it != indexes_.end()) {
+    positions_[it->second] = position;
+  } else {
+    indexes_[anchor_id] = positions_.size();
+    positions_.push_back(position);
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t RangeAnchorTable::size() const
+{
+  return positions_.size();
+}
+
+//-----------------------------------------------------------------------------
+size_t RangeAnchorTable::find(const std::string & anchor_id) const
+{
+  auto it = indexes_.find(anchor_id);
+  return it != indexes_.end() ? it->second : NOT_FOUND;
+}
+
+//-----------------------------------------------------------------------------
+const Eigen::Vector3d & RangeAnchorTable::get_position(const size_t & index) const
+{
+  return positions_[index];
+}
+
+//-----------------------------------------------------------------------------
+const Eigen::Vector3d & RangeAnchorTable::get_position(const std::string & anchor_id) const
+{
+  size_t index = find(anchor_id);
+  if (index == NOT_FOUND) {
+    throw(std::runtime_error("Unknown range anchor " + anchor_id));
+  }
+  return positions_[index];
+}
+
+//-----------------------------------------------------------------------------
+RangeAnchorTable RangeAnchorTable::load(const std::string & filename)
+{
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    throw(std::runtime_error("Unable to open range anchor file " + filename));
+  }
+
+  RangeAnchorTable table;
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+
+    std::istringstream stream(line);
+    std::string anchor_id;
+    if (!(stream >> anchor_id) || anchor_id[0] == '#') {
+      continue;
+    }
+
+    Eigen::Vector3d position;
+    if (!(stream >> position.x() >> position.y() >> position.z())) {
+      throw(std::runtime_error(
+          "Invalid range anchor at line " + std::to_string(line_number) + " of " + filename));
+    }
+    table.add(anchor_id, position);
+  }
+
+  return table;
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,296 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_checkpoint.hpp"
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+
+namespace
+{
+const char CHECKPOINT_MAGIC[8] = {'R', 'L', 'C', 'H', 'E', 'C', 'K', 'P'};
+const uint32_t CHECKPOINT_VERSION = 1;
+const size_t NUMBER_OF_SLOTS = 2;
+
+//-----------------------------------------------------------------------------
+uint64_t compute_checksum(const void * data, const size_t & size)
+{
+  // FNV-1a
+  const unsigned char * bytes = static_cast<const unsigned char *>(data);
+  uint64_t checksum = 14695981039346656037ull;
+  for (size_t n = 0; n < size; ++n) {
+    checksum ^= bytes[n];
+    checksum *= 1099511628211ull;
+  }
+  return checksum;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace ros2
+{
+
+struct LocalisationCheckpoint::Header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t capacity;
+};
+
+// generation is zero while slot is written, checksum covers all following fields
+// and slot values
+struct LocalisationCheckpoint::Slot
+{
+  uint64_t generation;
+  uint64_t checksum;
+  int64_t stamp;
+  uint32_t fsm_state;
+  uint32_t reserved;
+  int64_t state_rows;
+  int64_t state_cols;
+  int64_t covariance_rows;
+  int64_t covariance_cols;
+};
+
+//-----------------------------------------------------------------------------
+LocalisationCheckpoint::LocalisationCheckpoint(
+  const std::string & filename,
+  const size_t & capacity)
+: filename_(filename),
+  capacity_(capacity),
+  slot_size_(sizeof(Slot) + capacity * sizeof(double)),
+  file_descriptor_(-1),
+  mapping_size_(sizeof(Header) + NUMBER_OF_SLOTS * (sizeof(Slot) + capacity * sizeof(double))),
+  mapping_(MAP_FAILED),
+  header_(nullptr),
+  latest_slot_index_(0),
+  number_of_saves_(0)
+{
+  if (capacity_ == 0) {
+    throw(std::runtime_error("Checkpoint capacity must be strictly positive"));
+  }
+
+  // existing file is kept, it holds the checkpoint to restore
+  file_descriptor_ = ::open(filename_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file_descriptor_ < 0) {
+    throw(std::runtime_error("Unable to open checkpoint file " + filename_));
+  }
+
+  struct stat file_status;
+  if (::fstat(file_descriptor_, &file_status) != 0 ||
+    (static_cast<size_t>(file_status.st_size) != mapping_size_ &&
+    ::ftruncate(file_descriptor_, static_cast<off_t>(mapping_size_)) != 0))
+  {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Unable to allocate checkpoint file " + filename_));
+  }
+
+  mapping_ = ::mmap(
+    nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Unable to map checkpoint file " + filename_));
+  }
+
+  header_ = static_cast<Header *>(mapping_);
+  if (std::memcmp(header_->magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 ||
+    header_->version != CHECKPOINT_VERSION ||
+    header_->capacity != capacity_)
+  {
+    initialize_();
+  }
+
+  for (size_t n = 0; n < NUMBER_OF_SLOTS; ++n) {
+    number_of_saves_ = std::max(number_of_saves_, get_slot_(n).generation);
+  }
+
+  const Slot * latest = find_latest_slot_();
+  if (latest != nullptr && latest != &get_slot_(0)) {
+    latest_slot_index_ = 1;
+  }
+}
+
+//-----------------------------------------------------------------------------
+LocalisationCheckpoint::~LocalisationCheckpoint()
+{
+  ::msync(mapping_, mapping_size_, MS_SYNC);
+  ::munmap(mapping_, mapping_size_);
+  ::close(file_descriptor_);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationCheckpoint::initialize_()
+{
+  std::memset(mapping_, 0, mapping_size_);
+  std::memcpy(header_->magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  header_->version = CHECKPOINT_VERSION;
+  header_->capacity = capacity_;
+  ::msync(mapping_, mapping_size_, MS_SYNC);
+}
+
+//-----------------------------------------------------------------------------
+LocalisationCheckpoint::Slot & LocalisationCheckpoint::get_slot_(const size_t & index) const
+{
+  char * slots = static_cast<char *>(mapping_) + sizeof(Header);
+  return *reinterpret_cast<Slot *>(slots + index * slot_size_);
+}
+
+//-----------------------------------------------------------------------------
+double * LocalisationCheckpoint::get_values_(Slot & slot)
+{
+  return reinterpret_cast<double *>(&slot + 1);
+}
+
+//-----------------------------------------------------------------------------
+const double * LocalisationCheckpoint::get_values_(const Slot & slot) const
+{
+  return reinterpret_cast<const double *>(&slot + 1);
+}
+
+//-----------------------------------------------------------------------------
+LocalisationCheckpoint::Slot & LocalisationCheckpoint::begin_save_(
+  const core::Duration & stamp,
+  const uint32_t & fsm_state,
+  const Eigen::Index & state_rows,
+  const Eigen::Index & state_cols,
+  const Eigen::Index & covariance_rows,
+  const Eigen::Index & covariance_cols)
+{
+  if (static_cast<size_t>(state_rows * state_cols + covariance_rows * covariance_cols) >
+    capacity_)
+  {
+    throw(std::runtime_error("Filter state exceeds checkpoint capacity"));
+  }
+
+  // latest valid checkpoint is never overwritten
+  latest_slot_index_ = (latest_slot_index_ + 1) % NUMBER_OF_SLOTS;
+  Slot & slot = get_slot_(latest_slot_index_);
+  __atomic_store_n(&slot.generation, 0, __ATOMIC_RELAXED);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.stamp = stamp.count();
+  slot.fsm_state = fsm_state;
+  slot.state_rows = state_rows;
+  slot.state_cols = state_cols;
+  slot.covariance_rows = covariance_rows;
+  slot.covariance_cols = covariance_cols;
+  return slot;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationCheckpoint::end_save_(Slot & slot)
+{
+  slot.checksum = compute_checksum_(slot);
+
+  __atomic_store_n(&slot.generation, ++number_of_saves_, __ATOMIC_RELEASE);
+
+  // written back by the kernel in the background, a process crash loses nothing
+  ::msync(mapping_, mapping_size_, MS_ASYNC);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationCheckpoint::compute_checksum_(const Slot & slot) const
+{
+  size_t number_of_values = slot.state_rows * slot.state_cols +
+    slot.covariance_rows * slot.covariance_cols;
+  return compute_checksum(
+    &slot.stamp, sizeof(Slot) - offsetof(Slot, stamp) + number_of_values * sizeof(double));
+}
+
+//-----------------------------------------------------------------------------
+const LocalisationCheckpoint::Slot * LocalisationCheckpoint::find_latest_slot_() const
+{
+  const Slot * latest = nullptr;
+  for (size_t n = 0; n < NUMBER_OF_SLOTS; ++n) {
+    const Slot & slot = get_slot_(n);
+    uint64_t generation = __atomic_load_n(&slot.generation, __ATOMIC_ACQUIRE);
+    if (generation == 0 || (latest != nullptr && generation < latest->generation)) {
+      continue;
+    }
+
+    if (slot.state_rows < 0 || slot.state_cols < 0 ||
+      slot.covariance_rows < 0 || slot.covariance_cols < 0 ||
+      static_cast<size_t>(slot.state_rows * slot.state_cols +
+      slot.covariance_rows * slot.covariance_cols) > capacity_)
+    {
+      continue;
+    }
+
+    if (compute_checksum_(slot) == slot.checksum) {
+      latest = &slot;
+    }
+  }
+  return latest;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationCheckpoint::restore(
+  const core::Duration & now,
+  const core::Duration & maximal_age,
+  LocalisationCheckpointData & data) const
+{
+  const Slot * latest = find_latest_slot_();
+  if (latest == nullptr || now - core::Duration(latest->stamp) > maximal_age) {
+    return false;
+  }
+
+  const double * values = get_values_(*latest);
+  data.stamp = core::Duration(latest->stamp);
+  data.fsm_state = latest->fsm_state;
+  data.state = Eigen::Map<const Eigen::MatrixXd>(
+    values, latest->state_rows, latest->state_cols);
+  data.covariance = Eigen::Map<const Eigen::MatrixXd>(
+    values + data.state.size(), latest->covariance_rows, latest->covariance_cols);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationCheckpoint::get_capacity() const
+{
+  return capacity_;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationCheckpoint::get_number_of_saves() const
+{
+  return number_of_saves_;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationCheckpoint> make_checkpoint(
+  std::shared_ptr<rclcpp::Node> node,
+  const size_t & capacity)
+{
+  return std::make_shared<LocalisationCheckpoint>(get_checkpoint_filename(node), capacity);
+}
+
+}  // namespace ros2
+}  // namespace romea
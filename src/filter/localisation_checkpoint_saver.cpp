@@ -0,0 +1,103 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_checkpoint_saver.hpp"
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationCheckpointSaver::LocalisationCheckpointSaver(
+  std::shared_ptr<rclcpp::Node> node,
+  std::shared_ptr<LocalisationCheckpoint> checkpoint,
+  const double & period,
+  SnapshotFunction snapshot_function)
+: checkpoint_(checkpoint),
+  snapshot_function_(std::move(snapshot_function)),
+  timer_(nullptr),
+  stamp_(),
+  fsm_state_(core::LocalisationFSMState::INIT),
+  state_(),
+  covariance_(),
+  mutex_()
+{
+  if (period <= 0) {
+    throw(std::runtime_error("Invalid checkpoint period"));
+  }
+
+  auto timer_period = std::chrono::duration<double>(period);
+  timer_ = node->create_wall_timer(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(timer_period),
+    [this]() {save();});
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationCheckpointSaver::save()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!snapshot_function_(stamp_, fsm_state_, state_, covariance_)) {
+    return false;
+  }
+
+  checkpoint_->save(stamp_, static_cast<uint32_t>(fsm_state_), state_, covariance_);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<LocalisationCheckpointSaver> make_checkpoint_saver(
+  std::shared_ptr<rclcpp::Node> node,
+  std::shared_ptr<LocalisationCheckpoint> checkpoint,
+  LocalisationCheckpointSaver::SnapshotFunction snapshot_function)
+{
+  return std::make_unique<LocalisationCheckpointSaver>(
+    node, checkpoint, get_checkpoint_period(node), std::move(snapshot_function));
+}
+
+//-----------------------------------------------------------------------------
+bool restore_checkpoint(
+  std::shared_ptr<rclcpp::Node> node,
+  const LocalisationCheckpoint & checkpoint,
+  LocalisationCheckpointRestoreFunction restore_function)
+{
+  core::Duration now(node->get_clock()->now().nanoseconds());
+  core::Duration maximal_age = core::durationFromSecond(get_checkpoint_maximal_age(node));
+
+  LocalisationCheckpointData data;
+  if (!checkpoint.restore(now, maximal_age, data)) {
+    RCLCPP_INFO(node->get_logger(), "No recent checkpoint, filter starts cold");
+    return false;
+  }
+
+  restore_function(
+    data.stamp,
+    static_cast<core::LocalisationFSMState>(data.fsm_state),
+    data.state,
+    data.covariance);
+
+  RCLCPP_INFO(node->get_logger(), "Filter restored from checkpoint");
+  return true;
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,155 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_kld_sampling.hpp"
+
+namespace
+{
+
+const uint64_t BIN_INDEX_MASK = (uint64_t(1) << 21) - 1;
+
+//-----------------------------------------------------------------------------
+double upper_standard_normal_quantile(const double & confidence)
+{
+  // Abramowitz and Stegun 26.2.23, absolute error below 4.5e-4
+  double t = std::sqrt(-2 * std::log(1 - confidence));
+  return t - (2.515517 + 0.802853 * t + 0.010328 * t * t) /
+         (1 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t bin_index(const double & value, const double & bin_size)
+{
+  return static_cast<uint64_t>(static_cast<int64_t>(std::floor(value / bin_size))) &
+         BIN_INDEX_MASK;
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationKLDSampling::LocalisationKLDSampling(
+  const size_t & minimal_number_of_particles,
+  const size_t & maximal_number_of_particles,
+  const double & error,
+  const double & confidence,
+  const double & position_bin_size,
+  const double & orientation_bin_size)
+: minimal_number_of_particles_(minimal_number_of_particles),
+  maximal_number_of_particles_(maximal_number_of_particles),
+  error_(error),
+  quantile_(0),
+  position_bin_size_(position_bin_size),
+  orientation_bin_size_(orientation_bin_size),
+  occupied_bins_()
+{
+  if (minimal_number_of_particles_ == 0 ||
+    minimal_number_of_particles_ > maximal_number_of_particles_)
+  {
+    throw(std::runtime_error("Invalid KLD sampling number of particles range"));
+  }
+
+  if (error_ <= 0) {
+    throw(std::runtime_error("Invalid KLD sampling error"));
+  }
+
+  if (confidence <= 0.5 || confidence >= 1) {
+    throw(std::runtime_error("Invalid KLD sampling confidence"));
+  }
+
+  if (position_bin_size_ <= 0 || orientation_bin_size_ <= 0) {
+    throw(std::runtime_error("Invalid KLD sampling bin sizes"));
+  }
+
+  quantile_ = upper_standard_normal_quantile(confidence);
+  occupied_bins_.reserve(maximal_number_of_particles_);
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationKLDSampling::is_adaptive() const
+{
+  return minimal_number_of_particles_ != maximal_number_of_particles_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationKLDSampling::get_minimal_number_of_particles() const
+{
+  return minimal_number_of_particles_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationKLDSampling::get_maximal_number_of_particles() const
+{
+  return maximal_number_of_particles_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationKLDSampling::compute_number_of_particles(
+  const size_t & number_of_occupied_bins) const
+{
+  if (number_of_occupied_bins < 2) {
+    return minimal_number_of_particles_;
+  }
+
+  double k = static_cast<double>(number_of_occupied_bins - 1);
+  double a = 2 / (9 * k);
+  double b = 1 - a + std::sqrt(a) * quantile_;
+  double n = std::ceil(k / (2 * error_) * b * b * b);
+
+  if (n >= static_cast<double>(maximal_number_of_particles_)) {
+    return maximal_number_of_particles_;
+  }
+  return std::max(minimal_number_of_particles_, static_cast<size_t>(n));
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationKLDSampling::compute_number_of_particles(
+  const double * x,
+  const double * y,
+  const double * yaw,
+  const size_t & number_of_particles)
+{
+  return compute_number_of_particles(count_occupied_bins(x, y, yaw, number_of_particles));
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationKLDSampling::count_occupied_bins(
+  const double * x,
+  const double * y,
+  const double * yaw,
+  const size_t & number_of_particles)
+{
+  occupied_bins_.clear();
+  for (size_t n = 0; n < number_of_particles; ++n) {
+    double normalized_yaw = std::remainder(yaw[n], 2 * M_PI);
+    occupied_bins_.insert(
+      (bin_index(x[n], position_bin_size_) << 42) |
+      (bin_index(y[n], position_bin_size_) << 21) |
+      bin_index(normalized_yaw, orientation_bin_size_));
+  }
+  return occupied_bins_.size();
+}
+
+}  // namespace ros2
+}  // namespace romea
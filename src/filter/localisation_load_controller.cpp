@@ -0,0 +1,197 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// romea
+#include "romea_core_common/time/Time.hpp"
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_load_controller.hpp"
+
+namespace
+{
+const double SHEDDING_GAIN = 0.5;
+const double LOW_LOAD = 0.8;
+const double ARRIVAL_PERIOD_SMOOTHING = 0.1;
+}
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationLoadController::LocalisationLoadController(
+  const double & cpu_budget,
+  const Clock::duration & control_period)
+: cpu_budget_(cpu_budget),
+  control_period_(control_period),
+  mutex_(),
+  updaters_(),
+  has_period_start_(false),
+  period_start_time_(),
+  processing_time_(Clock::duration::zero()),
+  load_(0),
+  shedding_level_(0)
+{
+  if (cpu_budget_ <= 0) {
+    throw(std::runtime_error("Load controller requires a positive CPU budget"));
+  }
+
+  if (control_period_ <= Clock::duration::zero()) {
+    throw(std::runtime_error("Load controller requires a positive control period"));
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationLoadController::register_updater(
+  const std::string & updater_name,
+  const unsigned int & minimal_rate)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  updaters_.push_back({updater_name, double(minimal_rate), 0., false, {}, false, {}, 0});
+  return updaters_.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationLoadController::accept(
+  const size_t & updater_id,
+  const Clock::time_point & now)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  UpdaterState & updater = updaters_.at(updater_id);
+
+  if (updater.has_arrival) {
+    double period = std::chrono::duration<double>(now - updater.last_arrival_time).count();
+    updater.arrival_period = updater.arrival_period == 0 ? period :
+      (1 - ARRIVAL_PERIOD_SMOOTHING) * updater.arrival_period + ARRIVAL_PERIOD_SMOOTHING * period;
+  }
+  updater.has_arrival = true;
+  updater.last_arrival_time = now;
+
+  if (shedding_level_ > 0 && updater.has_accepted && updater.arrival_period > 0) {
+    double arrival_rate = 1 / updater.arrival_period;
+    double allowed_rate = updater.minimal_rate +
+      std::max(arrival_rate - updater.minimal_rate, 0.) * (1 - shedding_level_);
+
+    // half an arrival period of tolerance avoids aliasing with sensor rate
+    double elapsed = std::chrono::duration<double>(now - updater.last_accepted_time).count();
+    if (allowed_rate <= 0 || (elapsed + 0.5 * updater.arrival_period) * allowed_rate < 1) {
+      ++updater.number_of_decimated_messages;
+      return false;
+    }
+  }
+
+  updater.has_accepted = true;
+  updater.last_accepted_time = now;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationLoadController::record(
+  const size_t & /*updater_id*/,
+  const Clock::duration & processing_time,
+  const Clock::time_point & now)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!has_period_start_) {
+    has_period_start_ = true;
+    period_start_time_ = now - processing_time;
+  }
+
+  processing_time_ += processing_time;
+  if (now - period_start_time_ >= control_period_) {
+    update_shedding_level_(now);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationLoadController::update_shedding_level_(const Clock::time_point & now)
+{
+  double elapsed = std::chrono::duration<double>(now - period_start_time_).count();
+  load_ = std::chrono::duration<double>(processing_time_).count() / (cpu_budget_ * elapsed);
+
+  if (load_ > 1) {
+    shedding_level_ += SHEDDING_GAIN * (load_ - 1);
+  } else if (load_ < LOW_LOAD) {
+    shedding_level_ -= SHEDDING_GAIN * (LOW_LOAD - load_);
+  }
+  shedding_level_ = std::clamp(shedding_level_, 0., 1.);
+
+  period_start_time_ = now;
+  processing_time_ = Clock::duration::zero();
+}
+
+//-----------------------------------------------------------------------------
+double LocalisationLoadController::get_shedding_level() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return shedding_level_;
+}
+
+//-----------------------------------------------------------------------------
+double LocalisationLoadController::get_load() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return load_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationLoadController::get_number_of_decimated_messages(
+  const size_t & updater_id) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return updaters_.at(updater_id).number_of_decimated_messages;
+}
+
+//-----------------------------------------------------------------------------
+core::DiagnosticReport LocalisationLoadController::get_report() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  core::DiagnosticReport report;
+  report.info["filter_load"] = std::to_string(load_);
+  report.info["shedding_level"] = std::to_string(shedding_level_);
+  for (const auto & updater : updaters_) {
+    report.info[updater.updater_name + "_decimated"] =
+      std::to_string(updater.number_of_decimated_messages);
+  }
+
+  if (shedding_level_ >= 1 && load_ > 1) {
+    report.diagnostics.push_back(
+      core::Diagnostic(
+        core::DiagnosticStatus::WARN,
+        "Filter exceeds its CPU budget with all updaters at their minimal rate."));
+  }
+
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationLoadController> make_load_controller(
+  std::shared_ptr<rclcpp::Node> node)
+{
+  return std::make_shared<LocalisationLoadController>(
+    get_load_controller_cpu_budget(node),
+    std::chrono::duration_cast<LocalisationLoadController::Clock::duration>(
+      core::durationFromSecond(get_load_controller_period(node))));
+}
+
+}  // namespace ros2
+}  // namespace romea
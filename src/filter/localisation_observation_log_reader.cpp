@@ -0,0 +1,239 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_observation_log_reader.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationObservationLogReader::LocalisationObservationLogReader(const std::string & filename)
+: filename_(filename),
+  file_descriptor_(-1),
+  mapping_size_(0),
+  mapping_(MAP_FAILED),
+  header_(nullptr),
+  updater_names_(),
+  records_(),
+  updater_records_(),
+  number_of_incomplete_records_(0)
+{
+  file_descriptor_ = ::open(filename_.c_str(), O_RDONLY);
+  if (file_descriptor_ < 0) {
+    throw(std::runtime_error("Unable to open observation log " + filename_));
+  }
+
+  struct stat file_status;
+  if (::fstat(file_descriptor_, &file_status) != 0 ||
+    static_cast<size_t>(file_status.st_size) < sizeof(ObservationLogHeader))
+  {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Invalid observation log " + filename_));
+  }
+
+  mapping_size_ = static_cast<size_t>(file_status.st_size);
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Unable to map observation log " + filename_));
+  }
+
+  // records are read sequentially while indexing
+  ::madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+  header_ = static_cast<const ObservationLogHeader *>(mapping_);
+
+  try {
+    index_();
+  } catch (...) {
+    ::munmap(mapping_, mapping_size_);
+    ::close(file_descriptor_);
+    throw;
+  }
+}
+
+//-----------------------------------------------------------------------------
+LocalisationObservationLogReader::~LocalisationObservationLogReader()
+{
+  ::munmap(mapping_, mapping_size_);
+  ::close(file_descriptor_);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationObservationLogReader::index_()
+{
+  if (std::memcmp(header_->magic, OBSERVATION_LOG_MAGIC, sizeof(OBSERVATION_LOG_MAGIC)) != 0 ||
+    header_->version != OBSERVATION_LOG_VERSION ||
+    header_->record_size != sizeof(ObservationRecord) ||
+    header_->number_of_updaters > OBSERVATION_LOG_MAXIMAL_NUMBER_OF_UPDATERS ||
+    mapping_size_ < sizeof(ObservationLogHeader) + header_->capacity * sizeof(ObservationRecord))
+  {
+    throw(std::runtime_error("Invalid observation log " + filename_));
+  }
+
+  for (uint32_t n = 0; n < header_->number_of_updaters; ++n) {
+    updater_names_.emplace_back(
+      header_->updater_names[n],
+      strnlen(header_->updater_names[n], OBSERVATION_LOG_MAXIMAL_UPDATER_NAME_LENGTH));
+  }
+
+  // header record counter may be behind after a crash, slots are checked instead
+  const ObservationRecord * slots = reinterpret_cast<const ObservationRecord *>(header_ + 1);
+  records_.reserve(header_->capacity);
+  for (size_t n = 0; n < header_->capacity; ++n) {
+    const ObservationRecord & record = slots[n];
+    if (record.sequence == 0) {
+      continue;
+    }
+
+    if ((record.sequence - 1) % header_->capacity != n ||
+      record.updater_id >= updater_names_.size() ||
+      record.dimension == 0 ||
+      record.dimension > OBSERVATION_RECORD_MAXIMAL_DIMENSION)
+    {
+      ++number_of_incomplete_records_;
+      continue;
+    }
+
+    records_.push_back(&record);
+  }
+
+  std::sort(
+    records_.begin(), records_.end(),
+    [](const ObservationRecord * record1, const ObservationRecord * record2) {
+      return record1->stamp < record2->stamp ||
+      (record1->stamp == record2->stamp && record1->sequence < record2->sequence);
+    });
+
+  updater_records_.resize(updater_names_.size());
+  for (size_t n = 0; n < records_.size(); ++n) {
+    updater_records_[records_[n]->updater_id].push_back(n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+const std::string & LocalisationObservationLogReader::get_filename() const
+{
+  return filename_;
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<std::string> & LocalisationObservationLogReader::get_updater_names() const
+{
+  return updater_names_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationObservationLogReader::find_updater(const std::string & updater_name) const
+{
+  auto it = std::find(updater_names_.begin(), updater_names_.end(), updater_name);
+  return it != updater_names_.end() ? std::distance(updater_names_.begin(), it) : NOT_FOUND;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationObservationLogReader::size() const
+{
+  return records_.size();
+}
+
+//-----------------------------------------------------------------------------
+const ObservationRecord & LocalisationObservationLogReader::get_record(const size_t & index) const
+{
+  return *records_[index];
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<size_t> & LocalisationObservationLogReader::get_updater_records(
+  const uint16_t & updater_id) const
+{
+  return updater_records_.at(updater_id);
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationObservationLogReader::lower_bound(const core::Duration & stamp) const
+{
+  auto it = std::lower_bound(
+    records_.begin(), records_.end(), stamp.count(),
+    [](const ObservationRecord * record, const int64_t & value) {
+      return record->stamp < value;
+    });
+  return std::distance(records_.begin(), it);
+}
+
+//-----------------------------------------------------------------------------
+core::Duration LocalisationObservationLogReader::get_start_stamp() const
+{
+  return records_.empty() ? core::Duration::zero() : core::Duration(records_.front()->stamp);
+}
+
+//-----------------------------------------------------------------------------
+core::Duration LocalisationObservationLogReader::get_end_stamp() const
+{
+  return records_.empty() ? core::Duration::zero() : core::Duration(records_.back()->stamp);
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationObservationLogReader::get_number_of_incomplete_records() const
+{
+  return number_of_incomplete_records_;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<std::unique_ptr<LocalisationObservationLogReader>> open_observation_logs(
+  const std::vector<std::string> & filenames,
+  LocalisationThreadPool & thread_pool)
+{
+  std::vector<std::unique_ptr<LocalisationObservationLogReader>> readers(filenames.size());
+  std::vector<std::exception_ptr> errors(filenames.size());
+
+  thread_pool.parallel_for(
+    filenames.size(),
+    [&](size_t begin, size_t end) {
+      for (size_t n = begin; n < end; ++n) {
+        try {
+          readers[n] = std::make_unique<LocalisationObservationLogReader>(filenames[n]);
+        } catch (...) {
+          errors[n] = std::current_exception();
+        }
+      }
+    }, 1);
+
+  for (const auto & error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  return readers;
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,238 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// posix
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+
+namespace
+{
+
+// observations_20221012_153000.bin for observations.bin started at that date
+std::string make_timestamped_filename(const std::string & filename)
+{
+  std::time_t now = std::time(nullptr);
+  std::tm local_time;
+  localtime_r(&now, &local_time);
+
+  char stamp[32];
+  std::strftime(stamp, sizeof(stamp), "_%Y%m%d_%H%M%S", &local_time);
+
+  size_t extension = filename.find_last_of('.');
+  size_t directory = filename.find_last_of('/');
+  if (extension == std::string::npos ||
+    (directory != std::string::npos && extension < directory))
+  {
+    return filename + stamp;
+  }
+  return filename.substr(0, extension) + stamp + filename.substr(extension);
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationObservationRecorder::LocalisationObservationRecorder(
+  const std::string & filename,
+  const size_t & capacity,
+  const bool & ring_mode)
+: filename_(filename),
+  file_descriptor_(-1),
+  mapping_size_(sizeof(ObservationLogHeader) + capacity * sizeof(ObservationRecord)),
+  mapping_(MAP_FAILED),
+  header_(nullptr),
+  records_(nullptr),
+  capacity_(capacity),
+  ring_mode_(ring_mode),
+  registration_mutex_(),
+  number_of_records_(0),
+  number_of_dropped_records_(0)
+{
+  if (capacity_ == 0) {
+    throw(std::runtime_error("Observation recorder capacity must be strictly positive"));
+  }
+
+  file_descriptor_ = ::open(filename_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file_descriptor_ < 0) {
+    throw(std::runtime_error("Unable to open observation log " + filename_));
+  }
+
+  // log of a previous run may be the only trace of a crash
+  struct stat file_status;
+  if (::fstat(file_descriptor_, &file_status) != 0 || file_status.st_size != 0) {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Observation log " + filename_ + " already exists"));
+  }
+
+  // file is fully allocated now, records are never written to unbacked pages
+  if (::posix_fallocate(file_descriptor_, 0, static_cast<off_t>(mapping_size_)) != 0) {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Unable to allocate observation log " + filename_));
+  }
+
+  mapping_ = ::mmap(
+    nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(file_descriptor_);
+    throw(std::runtime_error("Unable to map observation log " + filename_));
+  }
+
+  header_ = static_cast<ObservationLogHeader *>(mapping_);
+  records_ = reinterpret_cast<ObservationRecord *>(header_ + 1);
+
+  std::memset(header_, 0, sizeof(ObservationLogHeader));
+  std::memcpy(header_->magic, OBSERVATION_LOG_MAGIC, sizeof(OBSERVATION_LOG_MAGIC));
+  header_->version = OBSERVATION_LOG_VERSION;
+  header_->record_size = sizeof(ObservationRecord);
+  header_->capacity = capacity_;
+  header_->ring_mode = ring_mode_;
+}
+
+//-----------------------------------------------------------------------------
+LocalisationObservationRecorder::~LocalisationObservationRecorder()
+{
+  flush();
+  ::munmap(mapping_, mapping_size_);
+  ::close(file_descriptor_);
+}
+
+//-----------------------------------------------------------------------------
+uint16_t LocalisationObservationRecorder::register_updater(const std::string & updater_name)
+{
+  std::lock_guard<std::mutex> lock(registration_mutex_);
+
+  if (updater_name.size() >= OBSERVATION_LOG_MAXIMAL_UPDATER_NAME_LENGTH) {
+    throw(std::runtime_error("Updater name " + updater_name + " is too long to be recorded"));
+  }
+
+  uint32_t updater_id = header_->number_of_updaters;
+  if (updater_id == OBSERVATION_LOG_MAXIMAL_NUMBER_OF_UPDATERS) {
+    throw(std::runtime_error("Too many updaters registered in observation recorder"));
+  }
+
+  std::strncpy(
+    header_->updater_names[updater_id], updater_name.c_str(),
+    OBSERVATION_LOG_MAXIMAL_UPDATER_NAME_LENGTH);
+  header_->number_of_updaters = updater_id + 1;
+  return static_cast<uint16_t>(updater_id);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationObservationRecorder::record(const ObservationRecord & record)
+{
+  uint64_t index = number_of_records_.fetch_add(1, std::memory_order_relaxed);
+
+  if (!ring_mode_ && index >= capacity_) {
+    number_of_dropped_records_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // slot is invalidated first so that a reader never takes a partially
+  // overwritten record for a complete one
+  ObservationRecord & slot = records_[index % capacity_];
+  __atomic_store_n(&slot.sequence, 0, __ATOMIC_RELAXED);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::memcpy(
+    reinterpret_cast<char *>(&slot) + sizeof(slot.sequence),
+    reinterpret_cast<const char *>(&record) + sizeof(record.sequence),
+    sizeof(ObservationRecord) - sizeof(record.sequence));
+
+  __atomic_store_n(&slot.sequence, index + 1, __ATOMIC_RELEASE);
+
+  // writers may finish out of order, header count only grows
+  uint64_t number_of_records = __atomic_load_n(&header_->number_of_records, __ATOMIC_RELAXED);
+  while (number_of_records < index + 1 &&
+    !__atomic_compare_exchange_n(
+      &header_->number_of_records, &number_of_records, index + 1,
+      true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+  {
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationObservationRecorder::flush()
+{
+  __atomic_store_n(
+    &header_->number_of_records, number_of_records_.load(), __ATOMIC_RELAXED);
+  ::msync(mapping_, mapping_size_, MS_SYNC);
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationObservationRecorder::get_capacity() const
+{
+  return capacity_;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationObservationRecorder::get_number_of_records() const
+{
+  uint64_t number_of_records = number_of_records_.load();
+  return ring_mode_ ? number_of_records : std::min<uint64_t>(number_of_records, capacity_);
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationObservationRecorder::get_number_of_dropped_records() const
+{
+  return number_of_dropped_records_.load();
+}
+
+//-----------------------------------------------------------------------------
+core::DiagnosticReport LocalisationObservationRecorder::get_report() const
+{
+  core::DiagnosticReport report;
+  report.info["recorded_observations"] = std::to_string(get_number_of_records());
+
+  uint64_t number_of_dropped_records = get_number_of_dropped_records();
+  if (number_of_dropped_records != 0) {
+    report.info["dropped_observations"] = std::to_string(number_of_dropped_records);
+    report.diagnostics.push_back(
+      core::Diagnostic(
+        core::DiagnosticStatus::WARN,
+        "Observation log " + filename_ + " is full."));
+  }
+
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationObservationRecorder> make_observation_recorder(
+  std::shared_ptr<rclcpp::Node> node)
+{
+  return std::make_shared<LocalisationObservationRecorder>(
+    make_timestamped_filename(get_recorder_filename(node)),
+    get_recorder_capacity(node),
+    get_recorder_ring_mode(node));
+}
+
+}  // namespace ros2
+}  // namespace romea
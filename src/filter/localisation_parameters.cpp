@@ -13,9 +13,11 @@
 // limitations under the License.
 
 // std
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 // romea
 #include "romea_localisation_utils/filter/localisation_parameters.hpp"
@@ -37,6 +39,13 @@ const char FILTER_NUMBER_OF_PARTICLES_PARAM_NAME[] =
   "filter.number_of_particles";
 const char FILTER_STATE_POOL_SIZE_PARAM_NAME[] =
   "filter.state_pool_size";
+const char FILTER_MAXIMAL_OBSERVATION_LATENCY_PARAM_NAME[] =
+  "filter.maximal_observation_latency";
+
+// a state pool size of zero means that it is derived from updater rates
+const int AUTO_STATE_POOL_SIZE = 0;
+const double DEFAULT_MAXIMAL_OBSERVATION_LATENCY = 0.5;
+const double STATE_POOL_SIZE_SAFETY_FACTOR = 1.5;
 
 const char UPDATER_TRIGGER_PARAM_NAME[] =
   "trigger";
@@ -44,6 +53,64 @@ const char UPDATER_MINIMAL_RATE_PARAM_NAME[] =
   "minimal_rate";
 const char UPDATER_MAHALANOBIS_DISTANCE_REJECTION_THRESHOLD_PARAM_NAME[] =
   "mahalanobis_distance_rejection_threshold";
+const char UPDATER_MAXIMAL_BATCH_SIZE_PARAM_NAME[] =
+  "maximal_batch_size";
+const char UPDATER_BATCH_WINDOW_PARAM_NAME[] =
+  "batch_window";
+const char UPDATER_PRIORITY_PARAM_NAME[] =
+  "priority";
+const char UPDATER_PREINTEGRATION_INTERVAL_PARAM_NAME[] =
+  "preintegration_interval";
+const char UPDATER_ANCHORS_FILENAME_PARAM_NAME[] =
+  "anchors_filename";
+const char UPDATER_ANCHORS_PARAM_NAME[] =
+  "anchors";
+
+const char EXTRAPOLATION_RATE_PARAM_NAME[] =
+  "extrapolation.rate";
+const char EXTRAPOLATION_MAXIMAL_HORIZON_PARAM_NAME[] =
+  "extrapolation.maximal_horizon";
+
+const char DISPATCHER_MAXIMAL_QUEUE_SIZE_PARAM_NAME[] =
+  "dispatcher.maximal_queue_size";
+const char DISPATCHER_MAXIMAL_DELAY_PARAM_NAME[] =
+  "dispatcher.maximal_delay";
+
+const char LOAD_CONTROLLER_CPU_BUDGET_PARAM_NAME[] =
+  "load_controller.cpu_budget";
+const char LOAD_CONTROLLER_PERIOD_PARAM_NAME[] =
+  "load_controller.period";
+
+const char SEQUENCER_REORDER_WINDOW_PARAM_NAME[] =
+  "sequencer.reorder_window";
+
+const char THREAD_POOL_NUMBER_OF_THREADS_PARAM_NAME[] =
+  "thread_pool.number_of_threads";
+
+const char RUNTIME_CPU_PARAM_NAME[] =
+  "runtime.cpu";
+const char RUNTIME_WAIT_TIMEOUT_PARAM_NAME[] =
+  "runtime.wait_timeout";
+
+const char RECORDER_FILENAME_PARAM_NAME[] =
+  "recorder.filename";
+const char RECORDER_CAPACITY_PARAM_NAME[] =
+  "recorder.capacity";
+const char RECORDER_RING_MODE_PARAM_NAME[] =
+  "recorder.ring_mode";
+
+const char CHECKPOINT_FILENAME_PARAM_NAME[] =
+  "checkpoint.filename";
+const char CHECKPOINT_PERIOD_PARAM_NAME[] =
+  "checkpoint.period";
+const char CHECKPOINT_MAXIMAL_AGE_PARAM_NAME[] =
+  "checkpoint.maximal_age";
+
+const char STATUS_KEEPALIVE_PERIOD_PARAM_NAME[] =
+  "status.keepalive_period";
+
+const char LEVER_ARMS_PARAM_NAME[] =
+  "lever_arms";
 
 }  // namespace
 
@@ -118,12 +185,14 @@ double get_predictor_maximal_circular_error_probable(std::shared_ptr<rclcpp::Nod
 void declare_kalman_filter_parameters(std::shared_ptr<rclcpp::Node> node)
 {
   declare_filter_state_pool_size(node);
+  declare_filter_maximal_observation_latency(node, DEFAULT_MAXIMAL_OBSERVATION_LATENCY);
 }
 
 //-----------------------------------------------------------------------------
 void declare_particle_filter_parameters(std::shared_ptr<rclcpp::Node> node)
 {
   declare_filter_state_pool_size(node);
+  declare_filter_maximal_observation_latency(node, DEFAULT_MAXIMAL_OBSERVATION_LATENCY);
   declare_filter_number_of_particles(node);
 }
 
@@ -142,13 +211,69 @@ size_t get_filter_number_of_particles(std::shared_ptr<rclcpp::Node> node)
 //-----------------------------------------------------------------------------
 void declare_filter_state_pool_size(std::shared_ptr<rclcpp::Node> node)
 {
-  declare_parameter<int>(node, FILTER_STATE_POOL_SIZE_PARAM_NAME);
+  declare_parameter_with_default<int>(
+    node, FILTER_STATE_POOL_SIZE_PARAM_NAME, AUTO_STATE_POOL_SIZE);
 }
 
 //-----------------------------------------------------------------------------
-size_t get_filter_state_pool_size(std::shared_ptr<rclcpp::Node> node)
+size_t get_filter_state_pool_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names)
 {
-  return static_cast<size_t>(get_parameter<int>(node, FILTER_STATE_POOL_SIZE_PARAM_NAME));
+  int state_pool_size = get_parameter<int>(node, FILTER_STATE_POOL_SIZE_PARAM_NAME);
+
+  if (state_pool_size < 0) {
+    throw(std::runtime_error("Invalid filter state pool size"));
+  }
+
+  if (state_pool_size != AUTO_STATE_POOL_SIZE) {
+    return static_cast<size_t>(state_pool_size);
+  }
+
+  std::vector<unsigned int> updater_minimal_rates;
+  for (const auto & updater_name : updater_names) {
+    updater_minimal_rates.push_back(get_updater_minimal_rate(node, updater_name));
+  }
+
+  return compute_filter_state_pool_size(
+    updater_minimal_rates, get_filter_maximal_observation_latency(node));
+}
+
+//-----------------------------------------------------------------------------
+void declare_filter_maximal_observation_latency(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, FILTER_MAXIMAL_OBSERVATION_LATENCY_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_filter_maximal_observation_latency(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<double>(node, FILTER_MAXIMAL_OBSERVATION_LATENCY_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+size_t compute_filter_state_pool_size(
+  const std::vector<unsigned int> & updater_minimal_rates,
+  const double & maximal_observation_latency)
+{
+  if (updater_minimal_rates.empty()) {
+    throw(std::runtime_error("Filter state pool size cannot be derived without updater rates"));
+  }
+
+  if (maximal_observation_latency <= 0) {
+    throw(std::runtime_error("Invalid filter maximal observation latency"));
+  }
+
+  // each processed observation stores one state in the pool
+  double number_of_observations = 0;
+  for (const auto & minimal_rate : updater_minimal_rates) {
+    number_of_observations += minimal_rate * maximal_observation_latency;
+  }
+
+  return static_cast<size_t>(std::ceil(number_of_observations * STATE_POOL_SIZE_SAFETY_FACTOR)) + 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -241,5 +366,549 @@ double get_updater_mahalanobis_distance_rejection_threshold(
     UPDATER_MAHALANOBIS_DISTANCE_REJECTION_THRESHOLD_PARAM_NAME);
 }
 
+//-----------------------------------------------------------------------------
+void declare_updater_maximal_batch_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const unsigned int & default_value)
+{
+  declare_parameter_with_default<int>(
+    node, updater_name, UPDATER_MAXIMAL_BATCH_SIZE_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+size_t get_updater_maximal_batch_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name)
+{
+  int maximal_batch_size = get_parameter<int>(
+    node, updater_name, UPDATER_MAXIMAL_BATCH_SIZE_PARAM_NAME);
+
+  if (maximal_batch_size < 1) {
+    throw(std::runtime_error("Invalid maximal batch size for updater " + updater_name));
+  }
+
+  return static_cast<size_t>(maximal_batch_size);
+}
+
+//-----------------------------------------------------------------------------
+void declare_updater_batch_window(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, updater_name, UPDATER_BATCH_WINDOW_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_updater_batch_window(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name)
+{
+  double batch_window = get_parameter<double>(
+    node, updater_name, UPDATER_BATCH_WINDOW_PARAM_NAME);
+
+  if (batch_window < 0) {
+    throw(std::runtime_error("Invalid batch window for updater " + updater_name));
+  }
+
+  return batch_window;
+}
+
+//-----------------------------------------------------------------------------
+void declare_updater_priority(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const int & default_value)
+{
+  declare_parameter_with_default<int>(
+    node, updater_name, UPDATER_PRIORITY_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+int get_updater_priority(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name)
+{
+  return get_parameter<int>(node, updater_name, UPDATER_PRIORITY_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_updater_preintegration_interval(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, updater_name, UPDATER_PREINTEGRATION_INTERVAL_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_updater_preintegration_interval(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name)
+{
+  double preintegration_interval = get_parameter<double>(
+    node, updater_name, UPDATER_PREINTEGRATION_INTERVAL_PARAM_NAME);
+
+  if (preintegration_interval < 0) {
+    throw(std::runtime_error("Invalid preintegration interval for updater " + updater_name));
+  }
+
+  return preintegration_interval;
+}
+
+//-----------------------------------------------------------------------------
+void declare_updater_range_anchors(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name)
+{
+  declare_parameter_with_default<std::string>(
+    node, updater_name, UPDATER_ANCHORS_FILENAME_PARAM_NAME, "");
+
+  // anchor ids are not known in advance, so anchor parameters are declared
+  // from overrides (parameters file or command line)
+  const std::string prefix = updater_name + "." + UPDATER_ANCHORS_PARAM_NAME + ".";
+  const auto & overrides = node->get_node_parameters_interface()->get_parameter_overrides();
+  for (const auto & [name, value] : overrides) {
+    if (name.compare(0, prefix.size(), prefix) == 0 && !node->has_parameter(name)) {
+      node->declare_parameter(name, value);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+RangeAnchorTable get_updater_range_anchors(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & updater_name)
+{
+  std::string filename = get_parameter<std::string>(
+    node, updater_name, UPDATER_ANCHORS_FILENAME_PARAM_NAME);
+
+  RangeAnchorTable anchors;
+  if (!filename.empty()) {
+    anchors = RangeAnchorTable::load(filename);
+  }
+
+  const std::string prefix = updater_name + "." + UPDATER_ANCHORS_PARAM_NAME + ".";
+  auto parameters = node->list_parameters(
+    {updater_name + "." + UPDATER_ANCHORS_PARAM_NAME},
+    rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE);
+
+  for (const auto & name : parameters.names) {
+    std::vector<double> position = node->get_parameter(name).as_double_array();
+    if (position.size() != 3) {
+      throw(std::runtime_error("Invalid position for range anchor " + name));
+    }
+    anchors.add(name.substr(prefix.size()), Eigen::Vector3d(position[0], position[1], position[2]));
+  }
+
+  return anchors;
+}
+
+//-----------------------------------------------------------------------------
+void declare_extrapolation_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_rate,
+  const double & default_maximal_horizon)
+{
+  declare_extrapolation_rate(node, default_rate);
+  declare_extrapolation_maximal_horizon(node, default_maximal_horizon);
+}
+
+//-----------------------------------------------------------------------------
+void declare_extrapolation_rate(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(node, EXTRAPOLATION_RATE_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_extrapolation_rate(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<double>(node, EXTRAPOLATION_RATE_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_extrapolation_maximal_horizon(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, EXTRAPOLATION_MAXIMAL_HORIZON_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_extrapolation_maximal_horizon(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<double>(node, EXTRAPOLATION_MAXIMAL_HORIZON_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_dispatcher_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const unsigned int & default_maximal_queue_size,
+  const double & default_maximal_delay)
+{
+  declare_dispatcher_maximal_queue_size(node, default_maximal_queue_size);
+  declare_dispatcher_maximal_delay(node, default_maximal_delay);
+}
+
+//-----------------------------------------------------------------------------
+void declare_dispatcher_maximal_queue_size(
+  std::shared_ptr<rclcpp::Node> node,
+  const unsigned int & default_value)
+{
+  declare_parameter_with_default<int>(
+    node, DISPATCHER_MAXIMAL_QUEUE_SIZE_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+size_t get_dispatcher_maximal_queue_size(std::shared_ptr<rclcpp::Node> node)
+{
+  int maximal_queue_size = get_parameter<int>(node, DISPATCHER_MAXIMAL_QUEUE_SIZE_PARAM_NAME);
+
+  if (maximal_queue_size < 1) {
+    throw(std::runtime_error("Invalid dispatcher maximal queue size"));
+  }
+
+  return static_cast<size_t>(maximal_queue_size);
+}
+
+//-----------------------------------------------------------------------------
+void declare_dispatcher_maximal_delay(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, DISPATCHER_MAXIMAL_DELAY_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_dispatcher_maximal_delay(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<double>(node, DISPATCHER_MAXIMAL_DELAY_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_load_controller_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_cpu_budget,
+  const double & default_period)
+{
+  declare_load_controller_cpu_budget(node, default_cpu_budget);
+  declare_load_controller_period(node, default_period);
+}
+
+//-----------------------------------------------------------------------------
+void declare_load_controller_cpu_budget(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, LOAD_CONTROLLER_CPU_BUDGET_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_load_controller_cpu_budget(std::shared_ptr<rclcpp::Node> node)
+{
+  double cpu_budget = get_parameter<double>(node, LOAD_CONTROLLER_CPU_BUDGET_PARAM_NAME);
+
+  if (cpu_budget <= 0) {
+    throw(std::runtime_error("Invalid load controller CPU budget"));
+  }
+
+  return cpu_budget;
+}
+
+//-----------------------------------------------------------------------------
+void declare_load_controller_period(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, LOAD_CONTROLLER_PERIOD_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_load_controller_period(std::shared_ptr<rclcpp::Node> node)
+{
+  double period = get_parameter<double>(node, LOAD_CONTROLLER_PERIOD_PARAM_NAME);
+
+  if (period <= 0) {
+    throw(std::runtime_error("Invalid load controller period"));
+  }
+
+  return period;
+}
+
+//-----------------------------------------------------------------------------
+void declare_thread_pool_number_of_threads(
+  std::shared_ptr<rclcpp::Node> node,
+  const unsigned int & default_value)
+{
+  declare_parameter_with_default<int>(
+    node, THREAD_POOL_NUMBER_OF_THREADS_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+size_t get_thread_pool_number_of_threads(std::shared_ptr<rclcpp::Node> node)
+{
+  int number_of_threads = get_parameter<int>(node, THREAD_POOL_NUMBER_OF_THREADS_PARAM_NAME);
+
+  if (number_of_threads < 1) {
+    throw(std::runtime_error("Invalid thread pool number of threads"));
+  }
+
+  return static_cast<size_t>(number_of_threads);
+}
+
+//-----------------------------------------------------------------------------
+void declare_runtime_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & default_cpu,
+  const double & default_wait_timeout)
+{
+  declare_runtime_cpu(node, default_cpu);
+  declare_runtime_wait_timeout(node, default_wait_timeout);
+}
+
+//-----------------------------------------------------------------------------
+void declare_runtime_cpu(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & default_value)
+{
+  declare_parameter_with_default<int>(node, RUNTIME_CPU_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+int get_runtime_cpu(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<int>(node, RUNTIME_CPU_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_runtime_wait_timeout(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(node, RUNTIME_WAIT_TIMEOUT_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_runtime_wait_timeout(std::shared_ptr<rclcpp::Node> node)
+{
+  double wait_timeout = get_parameter<double>(node, RUNTIME_WAIT_TIMEOUT_PARAM_NAME);
+
+  if (wait_timeout <= 0) {
+    throw(std::runtime_error("Invalid runtime wait timeout"));
+  }
+
+  return wait_timeout;
+}
+
+//-----------------------------------------------------------------------------
+void declare_sequencer_reorder_window(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(
+    node, SEQUENCER_REORDER_WINDOW_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_sequencer_reorder_window(std::shared_ptr<rclcpp::Node> node)
+{
+  double reorder_window = get_parameter<double>(node, SEQUENCER_REORDER_WINDOW_PARAM_NAME);
+
+  if (reorder_window < 0) {
+    throw(std::runtime_error("Invalid sequencer reorder window"));
+  }
+
+  return reorder_window;
+}
+
+//-----------------------------------------------------------------------------
+void declare_recorder_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_filename,
+  const int & default_capacity,
+  const bool & default_ring_mode)
+{
+  declare_recorder_filename(node, default_filename);
+  declare_recorder_capacity(node, default_capacity);
+  declare_recorder_ring_mode(node, default_ring_mode);
+}
+
+//-----------------------------------------------------------------------------
+void declare_recorder_filename(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_value)
+{
+  declare_parameter_with_default<std::string>(node, RECORDER_FILENAME_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+std::string get_recorder_filename(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<std::string>(node, RECORDER_FILENAME_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_recorder_capacity(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & default_value)
+{
+  declare_parameter_with_default<int>(node, RECORDER_CAPACITY_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+size_t get_recorder_capacity(std::shared_ptr<rclcpp::Node> node)
+{
+  int capacity = get_parameter<int>(node, RECORDER_CAPACITY_PARAM_NAME);
+
+  if (capacity <= 0) {
+    throw(std::runtime_error("Invalid recorder capacity"));
+  }
+
+  return static_cast<size_t>(capacity);
+}
+
+//-----------------------------------------------------------------------------
+void declare_recorder_ring_mode(
+  std::shared_ptr<rclcpp::Node> node,
+  const bool & default_value)
+{
+  declare_parameter_with_default<bool>(node, RECORDER_RING_MODE_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+bool get_recorder_ring_mode(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<bool>(node, RECORDER_RING_MODE_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_checkpoint_parameters(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_filename,
+  const double & default_period,
+  const double & default_maximal_age)
+{
+  declare_checkpoint_filename(node, default_filename);
+  declare_checkpoint_period(node, default_period);
+  declare_checkpoint_maximal_age(node, default_maximal_age);
+}
+
+//-----------------------------------------------------------------------------
+void declare_checkpoint_filename(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & default_value)
+{
+  declare_parameter_with_default<std::string>(node, CHECKPOINT_FILENAME_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+std::string get_checkpoint_filename(std::shared_ptr<rclcpp::Node> node)
+{
+  return get_parameter<std::string>(node, CHECKPOINT_FILENAME_PARAM_NAME);
+}
+
+//-----------------------------------------------------------------------------
+void declare_checkpoint_period(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(node, CHECKPOINT_PERIOD_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_checkpoint_period(std::shared_ptr<rclcpp::Node> node)
+{
+  double period = get_parameter<double>(node, CHECKPOINT_PERIOD_PARAM_NAME);
+
+  if (period <= 0) {
+    throw(std::runtime_error("Invalid checkpoint period"));
+  }
+
+  return period;
+}
+
+//-----------------------------------------------------------------------------
+void declare_checkpoint_maximal_age(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(node, CHECKPOINT_MAXIMAL_AGE_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_checkpoint_maximal_age(std::shared_ptr<rclcpp::Node> node)
+{
+  double maximal_age = get_parameter<double>(node, CHECKPOINT_MAXIMAL_AGE_PARAM_NAME);
+
+  if (maximal_age < 0) {
+    throw(std::runtime_error("Invalid checkpoint maximal age"));
+  }
+
+  return maximal_age;
+}
+
+//-----------------------------------------------------------------------------
+void declare_status_keepalive_period(
+  std::shared_ptr<rclcpp::Node> node,
+  const double & default_value)
+{
+  declare_parameter_with_default<double>(node, STATUS_KEEPALIVE_PERIOD_PARAM_NAME, default_value);
+}
+
+//-----------------------------------------------------------------------------
+double get_status_keepalive_period(std::shared_ptr<rclcpp::Node> node)
+{
+  double keepalive_period = get_parameter<double>(node, STATUS_KEEPALIVE_PERIOD_PARAM_NAME);
+
+  if (keepalive_period <= 0) {
+    throw(std::runtime_error("Invalid status keepalive period"));
+  }
+
+  return keepalive_period;
+}
+
+//-----------------------------------------------------------------------------
+void declare_lever_arms(std::shared_ptr<rclcpp::Node> node)
+{
+  // frame ids are not known in advance, lever arm parameters are declared from
+  // overrides as range anchors are
+  const std::string prefix = std::string(LEVER_ARMS_PARAM_NAME) + ".";
+  const auto & overrides = node->get_node_parameters_interface()->get_parameter_overrides();
+  for (const auto & [name, value] : overrides) {
+    if (name.compare(0, prefix.size(), prefix) == 0 && !node->has_parameter(name)) {
+      node->declare_parameter(name, value);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+LeverArmRegistry get_lever_arms(std::shared_ptr<rclcpp::Node> node)
+{
+  const std::string prefix = std::string(LEVER_ARMS_PARAM_NAME) + ".";
+  auto parameters = node->list_parameters(
+    {LEVER_ARMS_PARAM_NAME}, rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE);
+
+  LeverArmRegistry lever_arms;
+  for (const auto & name : parameters.names) {
+    std::vector<double> lever_arm = node->get_parameter(name).as_double_array();
+    if (lever_arm.size() != 3) {
+      throw(std::runtime_error("Invalid lever arm " + name));
+    }
+    lever_arms.set(
+      name.substr(prefix.size()), Eigen::Vector3d(lever_arm[0], lever_arm[1], lever_arm[2]));
+  }
+
+  return lever_arms;
+}
+
 }  // namespace ros2
 }  // namespace romea
@@ -0,0 +1,96 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// romea
+#include "romea_common_utils/qos.hpp"
+#include "romea_localisation_utils/conversions/observation_pose_conversions.hpp"
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_pose_extrapolation_publisher.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationPoseExtrapolationPublisher::LocalisationPoseExtrapolationPublisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const std::string & frame_id,
+  const double & rate,
+  const core::Duration & maximal_horizon)
+: extrapolator_(maximal_horizon),
+  clock_(node->get_clock()),
+  pub_(node, topic_name, frame_id, best_effort(1)),
+  timer_(nullptr)
+{
+  if (rate <= 0) {
+    throw(std::runtime_error("Invalid pose extrapolation rate"));
+  }
+
+  auto period = std::chrono::duration<double>(1 / rate);
+  timer_ = node->create_wall_timer(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(period),
+    std::bind(&LocalisationPoseExtrapolationPublisher::timer_callback_, this));
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPoseExtrapolationPublisher::update_pose(
+  const core::Duration & stamp,
+  const core::Pose2D & pose)
+{
+  extrapolator_.update_pose(stamp, pose);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPoseExtrapolationPublisher::update_twist(
+  const core::Duration & stamp,
+  const core::Twist2D & twist)
+{
+  extrapolator_.update_twist(stamp, twist);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPoseExtrapolationPublisher::timer_callback_()
+{
+  rclcpp::Time now = clock_->now();
+
+  core::Pose2D pose;
+  if (extrapolator_.extrapolate(core::Duration(now.nanoseconds()), pose)) {
+    pub_.publish(now, pose);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<LocalisationPoseExtrapolationPublisher> make_pose_extrapolation_publisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const std::string & frame_id)
+{
+  return std::make_unique<LocalisationPoseExtrapolationPublisher>(
+    node,
+    topic_name,
+    frame_id,
+    get_extrapolation_rate(node),
+    core::durationFromSecond(get_extrapolation_maximal_horizon(node)));
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,154 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <cmath>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_pose_extrapolator.hpp"
+
+namespace
+{
+const double MINIMAL_ANGULAR_SPEED = 1e-6;
+}
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationPoseExtrapolator::LocalisationPoseExtrapolator(const core::Duration & maximal_horizon)
+: maximal_horizon_(maximal_horizon),
+  pose_(),
+  twist_()
+{
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPoseExtrapolator::update_pose(
+  const core::Duration & stamp,
+  const core::Pose2D & pose)
+{
+  StampedPose stamped_pose;
+  stamped_pose.valid = true;
+  stamped_pose.stamp = stamp.count();
+  stamped_pose.x = pose.position.x();
+  stamped_pose.y = pose.position.y();
+  stamped_pose.yaw = pose.yaw;
+  std::copy(pose.covariance.data(), pose.covariance.data() + 9, stamped_pose.covariance);
+  pose_.store(stamped_pose);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPoseExtrapolator::update_twist(
+  const core::Duration & stamp,
+  const core::Twist2D & twist)
+{
+  StampedTwist stamped_twist;
+  stamped_twist.valid = true;
+  stamped_twist.stamp = stamp.count();
+  stamped_twist.linear_speed_x = twist.linearSpeeds.x();
+  stamped_twist.linear_speed_y = twist.linearSpeeds.y();
+  stamped_twist.angular_speed = twist.angularSpeed;
+  std::copy(twist.covariance.data(), twist.covariance.data() + 9, stamped_twist.covariance);
+  twist_.store(stamped_twist);
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationPoseExtrapolator::extrapolate(
+  const core::Duration & stamp,
+  core::Pose2D & pose) const
+{
+  StampedPose stamped_pose = pose_.load();
+  if (!stamped_pose.valid) {
+    return false;
+  }
+
+  // filter output stopped, a frozen pose stamped now would look valid downstream
+  core::Duration horizon = std::max(
+    stamp - core::Duration(stamped_pose.stamp), core::Duration::zero());
+  if (horizon > maximal_horizon_) {
+    return false;
+  }
+
+  pose.position.x() = stamped_pose.x;
+  pose.position.y() = stamped_pose.y;
+  pose.yaw = stamped_pose.yaw;
+  pose.covariance = Eigen::Matrix3d(stamped_pose.covariance);
+
+  // a stale twist is ignored, pose is then returned as is
+  StampedTwist stamped_twist = twist_.load();
+  if (!stamped_twist.valid || stamp - core::Duration(stamped_twist.stamp) > maximal_horizon_) {
+    return true;
+  }
+
+  core::Twist2D twist;
+  twist.linearSpeeds.x() = stamped_twist.linear_speed_x;
+  twist.linearSpeeds.y() = stamped_twist.linear_speed_y;
+  twist.angularSpeed = stamped_twist.angular_speed;
+  twist.covariance = Eigen::Matrix3d(stamped_twist.covariance);
+
+  pose = extrapolate(pose, twist, core::durationToSecond(horizon));
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+core::Pose2D LocalisationPoseExtrapolator::extrapolate(
+  const core::Pose2D & pose,
+  const core::Twist2D & twist,
+  const double & dt)
+{
+  const double & vx = twist.linearSpeeds.x();
+  const double & vy = twist.linearSpeeds.y();
+  const double & w = twist.angularSpeed;
+  double dtheta = w * dt;
+
+  // displacement expressed in body frame for a constant twist
+  double dx = vx * dt;
+  double dy = vy * dt;
+  if (std::abs(w) > MINIMAL_ANGULAR_SPEED) {
+    dx = (vx * std::sin(dtheta) + vy * (std::cos(dtheta) - 1)) / w;
+    dy = (vx * (1 - std::cos(dtheta)) + vy * std::sin(dtheta)) / w;
+  }
+
+  double cos_yaw = std::cos(pose.yaw);
+  double sin_yaw = std::sin(pose.yaw);
+  double dx_world = cos_yaw * dx - sin_yaw * dy;
+  double dy_world = sin_yaw * dx + cos_yaw * dy;
+
+  core::Pose2D extrapolated_pose;
+  extrapolated_pose.position.x() = pose.position.x() + dx_world;
+  extrapolated_pose.position.y() = pose.position.y() + dy_world;
+  extrapolated_pose.yaw = std::remainder(pose.yaw + dtheta, 2 * M_PI);
+
+  Eigen::Matrix3d F = Eigen::Matrix3d::Identity();
+  F(0, 2) = -dy_world;
+  F(1, 2) = dx_world;
+
+  Eigen::Matrix3d G = Eigen::Matrix3d::Zero();
+  G(0, 0) = cos_yaw * dt;
+  G(0, 1) = -sin_yaw * dt;
+  G(1, 0) = sin_yaw * dt;
+  G(1, 1) = cos_yaw * dt;
+  G(2, 2) = dt;
+
+  extrapolated_pose.covariance =
+    F * pose.covariance * F.transpose() + G * twist.covariance * G.transpose();
+  return extrapolated_pose;
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,270 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_priority_dispatcher.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationPriorityDispatcher::LocalisationPriorityDispatcher(
+  const size_t & maximal_queue_size,
+  const core::Duration & maximal_delay)
+: LocalisationDispatcherBase(),
+  maximal_queue_size_(maximal_queue_size),
+  maximal_delay_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(maximal_delay)),
+  mutex_(),
+  condition_(),
+  queues_(),
+  queue_size_(0),
+  statistics_(),
+  stop_(true),
+  thread_()
+{
+  if (maximal_queue_size_ == 0) {
+    throw(std::runtime_error("Priority dispatcher requires a non null queue size"));
+  }
+}
+
+//-----------------------------------------------------------------------------
+LocalisationPriorityDispatcher::~LocalisationPriorityDispatcher()
+{
+  stop();
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationPriorityDispatcher::register_updater(
+  const std::string & updater_name,
+  const int & priority)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.push_back({updater_name, priority, 0, 0, 0, {}});
+  return statistics_.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPriorityDispatcher::dispatch(
+  const size_t & updater_id,
+  const core::Duration & /*stamp*/,
+  Job && job)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int priority = statistics_.at(updater_id).priority;
+
+    if (queue_size_ == maximal_queue_size_) {
+      auto lowest = std::prev(queues_.end());
+      if (priority < lowest->first) {
+        ++statistics_[updater_id].number_of_shed_jobs;
+        return;
+      }
+
+      ++statistics_[lowest->second.front().updater_id].number_of_shed_jobs;
+      lowest->second.pop_front();
+      if (lowest->second.empty()) {
+        queues_.erase(lowest);
+      }
+      --queue_size_;
+    }
+
+    queues_[priority].push_back({updater_id, std::chrono::steady_clock::now(), std::move(job)});
+    ++queue_size_;
+  }
+  condition_.notify_one();
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationPriorityDispatcher::process_next()
+{
+  Job job;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stop_) {
+      throw(std::runtime_error("Priority dispatcher jobs are run by its thread once started"));
+    }
+
+    if (!pop_next_(job)) {
+      return false;
+    }
+  }
+
+  job();
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationPriorityDispatcher::pop_next_(Job & job)
+{
+  if (queue_size_ == 0) {
+    return false;
+  }
+
+  auto highest = queues_.begin();
+  Entry & entry = highest->second.front();
+  Statistics & statistics = statistics_[entry.updater_id];
+
+  auto delay = std::chrono::steady_clock::now() - entry.arrival_time;
+  statistics.maximal_delay = std::max(statistics.maximal_delay, delay);
+  if (delay > maximal_delay_) {
+    ++statistics.number_of_delayed_jobs;
+  }
+  ++statistics.number_of_processed_jobs;
+
+  job = std::move(entry.job);
+  highest->second.pop_front();
+  if (highest->second.empty()) {
+    queues_.erase(highest);
+  }
+  --queue_size_;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPriorityDispatcher::start()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stop_) {
+    stop_ = false;
+    thread_ = std::thread(&LocalisationPriorityDispatcher::run_, this);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPriorityDispatcher::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPriorityDispatcher::run_()
+{
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() {return stop_ || queue_size_ != 0;});
+      if (stop_) {
+        return;
+      }
+      pop_next_(job);
+    }
+    job();
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationPriorityDispatcher::get_queue_size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_size_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationPriorityDispatcher::get_number_of_shed_jobs(const size_t & updater_id) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_.at(updater_id).number_of_shed_jobs;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationPriorityDispatcher::get_number_of_delayed_jobs(const size_t & updater_id) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_.at(updater_id).number_of_delayed_jobs;
+}
+
+//-----------------------------------------------------------------------------
+core::DiagnosticReport LocalisationPriorityDispatcher::get_report() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  core::DiagnosticReport report;
+  report.info["dispatcher_queue_size"] = std::to_string(queue_size_);
+
+  size_t number_of_shed_jobs = 0;
+  for (const auto & statistics : statistics_) {
+    const std::string & name = statistics.updater_name;
+    report.info[name + "_processed"] = std::to_string(statistics.number_of_processed_jobs);
+    report.info[name + "_shed"] = std::to_string(statistics.number_of_shed_jobs);
+    report.info[name + "_delayed"] = std::to_string(statistics.number_of_delayed_jobs);
+    report.info[name + "_maximal_delay"] = std::to_string(
+      std::chrono::duration<double>(statistics.maximal_delay).count());
+    number_of_shed_jobs += statistics.number_of_shed_jobs;
+  }
+
+  if (number_of_shed_jobs != 0) {
+    report.diagnostics.push_back(
+      core::Diagnostic(
+        core::DiagnosticStatus::WARN,
+        "Filter is overloaded, low priority observations have been shed."));
+  }
+
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationPriorityDispatcher::append_to_report(
+  const size_t & updater_id,
+  core::DiagnosticReport & report) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  const Statistics & statistics = statistics_.at(updater_id);
+  report.info["dispatcher_processed"] = std::to_string(statistics.number_of_processed_jobs);
+  report.info["dispatcher_shed"] = std::to_string(statistics.number_of_shed_jobs);
+  report.info["dispatcher_delayed"] = std::to_string(statistics.number_of_delayed_jobs);
+  report.info["dispatcher_maximal_delay"] = std::to_string(
+    std::chrono::duration<double>(statistics.maximal_delay).count());
+
+  if (statistics.number_of_shed_jobs != 0) {
+    report.diagnostics.push_back(
+      core::Diagnostic(
+        core::DiagnosticStatus::WARN,
+        "Filter is overloaded, observations of " + statistics.updater_name +
+        " have been shed."));
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationPriorityDispatcher> make_priority_dispatcher(
+  std::shared_ptr<rclcpp::Node> node)
+{
+  auto dispatcher = std::make_shared<LocalisationPriorityDispatcher>(
+    get_dispatcher_maximal_queue_size(node),
+    core::durationFromSecond(get_dispatcher_maximal_delay(node)));
+  dispatcher->start();
+  return dispatcher;
+}
+
+}  // namespace ros2
+}  // namespace romea
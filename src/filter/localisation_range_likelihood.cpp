@@ -0,0 +1,335 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cmath>
+#include <stdexcept>
+
+// simd, AVX2 kernel is built for x86 whatever compile flags and selected at runtime
+#if defined(__x86_64__) && defined(__GNUC__)
+#define RANGE_LIKELIHOOD_AVX2_DISPATCH
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define RANGE_LIKELIHOOD_NEON
+#include <arm_neon.h>
+#endif
+
+// romea
+#include "romea_localisation_utils/filter/localisation_range_likelihood.hpp"
+
+namespace
+{
+
+// exponents below this value give a null likelihood
+const double MINIMAL_EXPONENT = -708.0;
+const double LOG2E = 1.4426950408889634;
+const double LN2_HI = 0.693145751953125;
+const double LN2_LO = 1.42860682030941723212e-6;
+
+// 1/k! for k = 11 ... 0, Taylor expansion of exp on [-ln2/2, ln2/2]
+const double EXP_COEFFICIENTS[] = {
+  2.505210838544172e-08, 2.755731922398589e-07, 2.755731922398589e-06,
+  2.48015873015873e-05, 0.0001984126984126984, 0.001388888888888889,
+  0.008333333333333333, 0.04166666666666666, 0.1666666666666667,
+  0.5, 1.0, 1.0};
+
+struct RangeGeometry
+{
+  explicit RangeGeometry(const romea::core::ObservationRange & observation)
+  : range(observation.Y()),
+    gain(-0.5 / observation.R()),
+    lever_arm_x(observation.initiatorPosition.x()),
+    lever_arm_y(observation.initiatorPosition.y()),
+    anchor_x(observation.responderPosition.x()),
+    anchor_y(observation.responderPosition.y()),
+    dz2(std::pow(observation.initiatorPosition.z() - observation.responderPosition.z(), 2))
+  {
+    if (observation.R() <= 0) {
+      throw(std::runtime_error("Range likelihood requires a positive range variance"));
+    }
+  }
+
+  double range;
+  double gain;
+  double lever_arm_x;
+  double lever_arm_y;
+  double anchor_x;
+  double anchor_y;
+  double dz2;
+};
+
+#if defined(RANGE_LIKELIHOOD_AVX2_DISPATCH)
+//-----------------------------------------------------------------------------
+bool cpu_supports_avx2()
+{
+  static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return supported;
+}
+
+//-----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+inline __m256d fmadd(const __m256d & a, const __m256d & b, const __m256d & c)
+{
+  return _mm256_fmadd_pd(a, b, c);
+}
+
+//-----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+inline __m256d exp(const __m256d & x)
+{
+  const __m256d magic = _mm256_set1_pd(6755399441055744.0);  // 2^52 + 2^51
+
+  __m256d clamped = _mm256_max_pd(x, _mm256_set1_pd(MINIMAL_EXPONENT));
+  __m256d n = _mm256_round_pd(
+    _mm256_mul_pd(clamped, _mm256_set1_pd(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  __m256d r = fmadd(n, _mm256_set1_pd(-LN2_HI), clamped);
+  r = fmadd(n, _mm256_set1_pd(-LN2_LO), r);
+
+  __m256d p = _mm256_set1_pd(EXP_COEFFICIENTS[0]);
+  for (size_t k = 1; k < 12; ++k) {
+    p = fmadd(p, r, _mm256_set1_pd(EXP_COEFFICIENTS[k]));
+  }
+
+  // 2^n built from the exponent bits
+  __m256i bits = _mm256_sub_epi64(
+    _mm256_castpd_si256(_mm256_add_pd(n, magic)), _mm256_castpd_si256(magic));
+  bits = _mm256_slli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(1023)), 52);
+  __m256d result = _mm256_mul_pd(p, _mm256_castsi256_pd(bits));
+
+  __m256d underflow = _mm256_cmp_pd(x, _mm256_set1_pd(MINIMAL_EXPONENT), _CMP_LT_OQ);
+  return _mm256_andnot_pd(underflow, result);
+}
+
+//-----------------------------------------------------------------------------
+// returns the index of the first particle left to the scalar loop
+template<bool Weighting>
+__attribute__((target("avx2,fma")))
+size_t evaluate_avx2(
+  const RangeGeometry & geometry,
+  const double * x,
+  const double * y,
+  const double * cos_yaw,
+  const double * sin_yaw,
+  const size_t & begin,
+  const size_t & end,
+  double * output)
+{
+  const __m256d range = _mm256_set1_pd(geometry.range);
+  const __m256d gain = _mm256_set1_pd(geometry.gain);
+  const __m256d lever_arm_x = _mm256_set1_pd(geometry.lever_arm_x);
+  const __m256d lever_arm_y = _mm256_set1_pd(geometry.lever_arm_y);
+  const __m256d anchor_x = _mm256_set1_pd(geometry.anchor_x);
+  const __m256d anchor_y = _mm256_set1_pd(geometry.anchor_y);
+  const __m256d dz2 = _mm256_set1_pd(geometry.dz2);
+
+  size_t n = begin;
+  for (; n + 4 <= end; n += 4) {
+    __m256d c = _mm256_loadu_pd(cos_yaw + n);
+    __m256d s = _mm256_loadu_pd(sin_yaw + n);
+    __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + n), anchor_x);
+    __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + n), anchor_y);
+    dx = fmadd(c, lever_arm_x, fmadd(s, _mm256_sub_pd(_mm256_setzero_pd(), lever_arm_y), dx));
+    dy = fmadd(s, lever_arm_x, fmadd(c, lever_arm_y, dy));
+    __m256d d2 = fmadd(dx, dx, fmadd(dy, dy, dz2));
+    __m256d e = _mm256_sub_pd(range, _mm256_sqrt_pd(d2));
+    __m256d likelihood = exp(_mm256_mul_pd(gain, _mm256_mul_pd(e, e)));
+    if constexpr (Weighting) {
+      likelihood = _mm256_mul_pd(likelihood, _mm256_loadu_pd(output + n));
+    }
+    _mm256_storeu_pd(output + n, likelihood);
+  }
+  return n;
+}
+#elif defined(RANGE_LIKELIHOOD_NEON)
+//-----------------------------------------------------------------------------
+inline float64x2_t exp(const float64x2_t & x)
+{
+  float64x2_t clamped = vmaxq_f64(x, vdupq_n_f64(MINIMAL_EXPONENT));
+  float64x2_t n = vrndnq_f64(vmulq_f64(clamped, vdupq_n_f64(LOG2E)));
+  float64x2_t r = vfmsq_f64(clamped, n, vdupq_n_f64(LN2_HI));
+  r = vfmsq_f64(r, n, vdupq_n_f64(LN2_LO));
+
+  float64x2_t p = vdupq_n_f64(EXP_COEFFICIENTS[0]);
+  for (size_t k = 1; k < 12; ++k) {
+    p = vfmaq_f64(vdupq_n_f64(EXP_COEFFICIENTS[k]), p, r);
+  }
+
+  // 2^n built from the exponent bits
+  int64x2_t bits = vshlq_n_s64(vaddq_s64(vcvtq_s64_f64(n), vdupq_n_s64(1023)), 52);
+  float64x2_t result = vmulq_f64(p, vreinterpretq_f64_s64(bits));
+
+  uint64x2_t underflow = vcltq_f64(x, vdupq_n_f64(MINIMAL_EXPONENT));
+  return vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(result), underflow));
+}
+#endif
+
+}  // namespace
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationRangeLikelihood::LocalisationRangeLikelihood()
+: x_(nullptr),
+  y_(nullptr),
+  cos_yaw_(),
+  sin_yaw_(),
+  number_of_particles_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationRangeLikelihood::set_particles(
+  const double * x,
+  const double * y,
+  const double * yaw,
+  const size_t & number_of_particles)
+{
+  x_ = x;
+  y_ = y;
+  number_of_particles_ = number_of_particles;
+  cos_yaw_.resize(number_of_particles);
+  sin_yaw_.resize(number_of_particles);
+  for (size_t n = 0; n < number_of_particles; ++n) {
+    cos_yaw_[n] = std::cos(yaw[n]);
+    sin_yaw_[n] = std::sin(yaw[n]);
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationRangeLikelihood::get_number_of_particles() const
+{
+  return number_of_particles_;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationRangeLikelihood::evaluate(
+  const core::ObservationRange & observation,
+  double * likelihoods) const
+{
+  evaluate_<false>(observation, 0, number_of_particles_, likelihoods);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationRangeLikelihood::weight(
+  const core::ObservationRange & observation,
+  double * weights,
+  const size_t & begin,
+  const size_t & end) const
+{
+  evaluate_<true>(observation, begin, end, weights);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationRangeLikelihood::weight(
+  const core::ObservationRange & observation,
+  double * weights) const
+{
+  evaluate_<true>(observation, 0, number_of_particles_, weights);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationRangeLikelihood::evaluate_scalar(
+  const core::ObservationRange & observation,
+  double * likelihoods) const
+{
+  evaluate_scalar_<false>(observation, 0, number_of_particles_, likelihoods);
+}
+
+//-----------------------------------------------------------------------------
+const char * LocalisationRangeLikelihood::simd_instruction_set()
+{
+#if defined(RANGE_LIKELIHOOD_AVX2_DISPATCH)
+  return cpu_supports_avx2() ? "avx2" : "none";
+#elif defined(RANGE_LIKELIHOOD_NEON)
+  return "neon";
+#else
+  return "none";
+#endif
+}
+
+//-----------------------------------------------------------------------------
+template<bool Weighting>
+void LocalisationRangeLikelihood::evaluate_(
+  const core::ObservationRange & observation,
+  const size_t & begin,
+  const size_t & end,
+  double * output) const
+{
+  RangeGeometry geometry(observation);
+  size_t n = begin;
+
+#if defined(RANGE_LIKELIHOOD_AVX2_DISPATCH)
+  if (cpu_supports_avx2()) {
+    n = evaluate_avx2<Weighting>(
+      geometry, x_, y_, cos_yaw_.data(), sin_yaw_.data(), begin, end, output);
+  }
+#elif defined(RANGE_LIKELIHOOD_NEON)
+  const float64x2_t range = vdupq_n_f64(geometry.range);
+  const float64x2_t gain = vdupq_n_f64(geometry.gain);
+  const float64x2_t lever_arm_x = vdupq_n_f64(geometry.lever_arm_x);
+  const float64x2_t lever_arm_y = vdupq_n_f64(geometry.lever_arm_y);
+  const float64x2_t anchor_x = vdupq_n_f64(geometry.anchor_x);
+  const float64x2_t anchor_y = vdupq_n_f64(geometry.anchor_y);
+  const float64x2_t dz2 = vdupq_n_f64(geometry.dz2);
+
+  for (; n + 2 <= end; n += 2) {
+    float64x2_t c = vld1q_f64(cos_yaw_.data() + n);
+    float64x2_t s = vld1q_f64(sin_yaw_.data() + n);
+    float64x2_t dx = vsubq_f64(vld1q_f64(x_ + n), anchor_x);
+    float64x2_t dy = vsubq_f64(vld1q_f64(y_ + n), anchor_y);
+    dx = vfmsq_f64(vfmaq_f64(dx, c, lever_arm_x), s, lever_arm_y);
+    dy = vfmaq_f64(vfmaq_f64(dy, s, lever_arm_x), c, lever_arm_y);
+    float64x2_t d2 = vfmaq_f64(vfmaq_f64(dz2, dx, dx), dy, dy);
+    float64x2_t e = vsubq_f64(range, vsqrtq_f64(d2));
+    float64x2_t likelihood = exp(vmulq_f64(gain, vmulq_f64(e, e)));
+    if constexpr (Weighting) {
+      likelihood = vmulq_f64(likelihood, vld1q_f64(output + n));
+    }
+    vst1q_f64(output + n, likelihood);
+  }
+#endif
+
+  // remaining particles, or all of them without simd support
+  evaluate_scalar_<Weighting>(observation, n, end, output);
+}
+
+//-----------------------------------------------------------------------------
+template<bool Weighting>
+void LocalisationRangeLikelihood::evaluate_scalar_(
+  const core::ObservationRange & observation,
+  const size_t & begin,
+  const size_t & end,
+  double * output) const
+{
+  RangeGeometry geometry(observation);
+  for (size_t n = begin; n < end; ++n) {
+    double dx = x_[n] - geometry.anchor_x +
+      cos_yaw_[n] * geometry.lever_arm_x - sin_yaw_[n] * geometry.lever_arm_y;
+    double dy = y_[n] - geometry.anchor_y +
+      sin_yaw_[n] * geometry.lever_arm_x + cos_yaw_[n] * geometry.lever_arm_y;
+    double e = geometry.range - std::sqrt(dx * dx + dy * dy + geometry.dz2);
+    double likelihood = std::exp(geometry.gain * e * e);
+    if constexpr (Weighting) {
+      output[n] *= likelihood;
+    } else {
+      output[n] = likelihood;
+    }
+  }
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,194 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_sequencer.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+bool LocalisationSequencer::Entry::operator>(const Entry & other) const
+{
+  return std::tie(stamp, updater_id, sequence) >
+         std::tie(other.stamp, other.updater_id, other.sequence);
+}
+
+//-----------------------------------------------------------------------------
+LocalisationSequencer::LocalisationSequencer(const core::Duration & reorder_window)
+: LocalisationDispatcherBase(),
+  reorder_window_(reorder_window.count()),
+  mutex_(),
+  pending_jobs_(),
+  updater_names_(),
+  latest_stamps_(),
+  has_stamps_(),
+  numbers_of_late_jobs_(),
+  latest_stamp_(std::numeric_limits<int64_t>::min()),
+  last_released_stamp_(std::numeric_limits<int64_t>::min()),
+  has_released_(false),
+  sequence_(0),
+  number_of_late_jobs_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationSequencer::register_updater(
+  const std::string & updater_name,
+  const int & /*priority*/)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  updater_names_.push_back(updater_name);
+  latest_stamps_.push_back(std::numeric_limits<int64_t>::min());
+  has_stamps_.push_back(false);
+  numbers_of_late_jobs_.push_back(0);
+  return updater_names_.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationSequencer::dispatch(
+  const size_t & updater_id,
+  const core::Duration & stamp,
+  Job && job)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  int64_t stamp_ns = stamp.count();
+  latest_stamps_.at(updater_id) = std::max(latest_stamps_[updater_id], stamp_ns);
+  has_stamps_[updater_id] = true;
+  latest_stamp_ = std::max(latest_stamp_, stamp_ns);
+
+  Entry entry{stamp_ns, updater_id, sequence_++, std::move(job)};
+  if (has_released_ && stamp_ns < last_released_stamp_) {
+    // released by reorder window, filter has to roll back
+    ++number_of_late_jobs_;
+    ++numbers_of_late_jobs_[updater_id];
+    run_(entry.stamp, entry.job);
+    return;
+  }
+  pending_jobs_.push(std::move(entry));
+
+  int64_t watermark = std::numeric_limits<int64_t>::min();
+  if (std::all_of(has_stamps_.begin(), has_stamps_.end(), [](bool has) {return has;})) {
+    watermark = *std::min_element(latest_stamps_.begin(), latest_stamps_.end());
+  }
+
+  if (reorder_window_ > 0) {
+    watermark = std::max(watermark, latest_stamp_ - reorder_window_);
+  }
+
+  release_(watermark);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationSequencer::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  release_(std::numeric_limits<int64_t>::max());
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationSequencer::release_(const int64_t & watermark)
+{
+  while (!pending_jobs_.empty() && pending_jobs_.top().stamp <= watermark) {
+    // job is mutable so it can be moved out of the queue top
+    int64_t stamp = pending_jobs_.top().stamp;
+    Job job = std::move(pending_jobs_.top().job);
+    pending_jobs_.pop();
+    run_(stamp, job);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationSequencer::run_(const int64_t & stamp, const Job & job)
+{
+  // jobs are run under lock so that they reach the filter in release order
+  if (!has_released_ || stamp > last_released_stamp_) {
+    last_released_stamp_ = stamp;
+  }
+  has_released_ = true;
+  job();
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationSequencer::get_number_of_pending_jobs() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_jobs_.size();
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationSequencer::get_number_of_dispatched_jobs() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sequence_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationSequencer::get_number_of_late_jobs() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return number_of_late_jobs_;
+}
+
+//-----------------------------------------------------------------------------
+core::DiagnosticReport LocalisationSequencer::get_report() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  core::DiagnosticReport report;
+  report.info["sequencer_dispatched_jobs"] = std::to_string(sequence_);
+  report.info["sequencer_pending_jobs"] = std::to_string(pending_jobs_.size());
+  report.info["sequencer_late_jobs"] = std::to_string(number_of_late_jobs_);
+
+  if (number_of_late_jobs_ != 0) {
+    report.diagnostics.push_back(
+      core::Diagnostic(
+        core::DiagnosticStatus::WARN,
+        "Some observations arrived after the reorder window, processing order "
+        "is not deterministic."));
+  }
+
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationSequencer::append_to_report(
+  const size_t & updater_id,
+  core::DiagnosticReport & report) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  report.info["sequencer_late_jobs"] = std::to_string(numbers_of_late_jobs_.at(updater_id));
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationSequencer> make_sequencer(std::shared_ptr<rclcpp::Node> node)
+{
+  return std::make_shared<LocalisationSequencer>(
+    core::durationFromSecond(get_sequencer_reorder_window(node)));
+}
+
+}  // namespace ros2
+}  // namespace romea
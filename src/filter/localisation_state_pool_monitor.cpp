@@ -0,0 +1,143 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_state_pool_monitor.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationStatePoolMonitor::LocalisationStatePoolMonitor(const size_t & state_pool_size)
+: mutex_(),
+  state_pool_size_(state_pool_size),
+  stamps_(),
+  latest_stamp_(0),
+  maximal_rollback_depth_(0),
+  number_of_rollbacks_(0),
+  number_of_out_of_pool_rollbacks_(0)
+{
+  if (state_pool_size == 0) {
+    throw(std::runtime_error("State pool monitor requires a non empty state pool"));
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationStatePoolMonitor::check(const core::Duration & stamp)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  int64_t stamp_ns = stamp.count();
+  if (!stamps_.empty() && stamp_ns < latest_stamp_) {
+    ++number_of_rollbacks_;
+    maximal_rollback_depth_ = std::max(maximal_rollback_depth_, latest_stamp_ - stamp_ns);
+
+    // stamps are kept sorted, whatever their arrival order, so the first one is the oldest
+    if (stamps_.size() == state_pool_size_ && stamp_ns < *stamps_.begin()) {
+      ++number_of_out_of_pool_rollbacks_;
+      return false;
+    }
+  }
+
+  stamps_.insert(stamp_ns);
+  if (stamps_.size() > state_pool_size_) {
+    stamps_.erase(stamps_.begin());
+  }
+  latest_stamp_ = std::max(latest_stamp_, stamp_ns);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationStatePoolMonitor::get_state_pool_size() const
+{
+  return state_pool_size_;
+}
+
+//-----------------------------------------------------------------------------
+core::Duration LocalisationStatePoolMonitor::get_time_span() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stamps_.empty()) {
+    return core::Duration::zero();
+  }
+
+  return core::Duration(latest_stamp_ - *stamps_.begin());
+}
+
+//-----------------------------------------------------------------------------
+core::Duration LocalisationStatePoolMonitor::get_maximal_rollback_depth() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return core::Duration(maximal_rollback_depth_);
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationStatePoolMonitor::get_number_of_rollbacks() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return number_of_rollbacks_;
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationStatePoolMonitor::get_number_of_out_of_pool_rollbacks() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return number_of_out_of_pool_rollbacks_;
+}
+
+//-----------------------------------------------------------------------------
+core::DiagnosticReport LocalisationStatePoolMonitor::get_report() const
+{
+  core::DiagnosticReport report;
+  size_t number_of_out_of_pool_rollbacks = get_number_of_out_of_pool_rollbacks();
+
+  report.info["state_pool_size"] = std::to_string(get_state_pool_size());
+  report.info["state_pool_time_span"] =
+    std::to_string(core::durationToSecond(get_time_span()));
+  report.info["maximal_rollback_depth"] =
+    std::to_string(core::durationToSecond(get_maximal_rollback_depth()));
+  report.info["rollbacks"] = std::to_string(get_number_of_rollbacks());
+  report.info["out_of_pool_rollbacks"] = std::to_string(number_of_out_of_pool_rollbacks);
+
+  if (number_of_out_of_pool_rollbacks != 0) {
+    report.diagnostics.push_back(
+      core::Diagnostic(
+        core::DiagnosticStatus::WARN,
+        "Filter state pool is too small to cover observation latency."));
+  }
+
+  return report;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationStatePoolMonitor> make_state_pool_monitor(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::vector<std::string> & updater_names)
+{
+  return std::make_shared<LocalisationStatePoolMonitor>(
+    get_filter_state_pool_size(node, updater_names));
+}
+
+}  // namespace ros2
+}  // namespace romea
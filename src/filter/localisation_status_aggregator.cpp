@@ -0,0 +1,122 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <string>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_status_aggregator.hpp"
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+int get_severity(const romea::core::LocalisationFSMState & fsm_state)
+{
+  switch (fsm_state) {
+    case romea::core::LocalisationFSMState::RUNNING:
+      return 0;
+    case romea::core::LocalisationFSMState::INIT:
+      return 1;
+    default:
+      return 2;
+  }
+}
+
+}  // namespace
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationStatusAggregator::LocalisationStatusAggregator()
+: source_names_(),
+  source_states_(),
+  status_(core::LocalisationFSMState::INIT),
+  number_of_transitions_(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationStatusAggregator::register_source(const std::string & source_name)
+{
+  source_names_.push_back(source_name);
+  source_states_.push_back(core::LocalisationFSMState::INIT);
+  aggregate_();
+  return source_names_.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+bool LocalisationStatusAggregator::update(
+  const size_t & source_id,
+  const core::LocalisationFSMState & fsm_state)
+{
+  if (source_states_[source_id] == fsm_state) {
+    return false;
+  }
+
+  core::LocalisationFSMState previous_status = status_;
+  source_states_[source_id] = fsm_state;
+  aggregate_();
+  return status_ != previous_status;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationStatusAggregator::aggregate_()
+{
+  core::LocalisationFSMState status = core::LocalisationFSMState::RUNNING;
+  for (const auto & fsm_state : source_states_) {
+    if (get_severity(fsm_state) > get_severity(status)) {
+      status = fsm_state;
+    }
+  }
+
+  if (source_states_.empty()) {
+    status = core::LocalisationFSMState::INIT;
+  }
+
+  if (status != status_) {
+    status_ = status;
+    ++number_of_transitions_;
+  }
+}
+
+//-----------------------------------------------------------------------------
+core::LocalisationFSMState LocalisationStatusAggregator::get_status() const
+{
+  return status_;
+}
+
+//-----------------------------------------------------------------------------
+const std::string & LocalisationStatusAggregator::get_source_name(const size_t & source_id) const
+{
+  return source_names_[source_id];
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationStatusAggregator::get_number_of_sources() const
+{
+  return source_names_.size();
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationStatusAggregator::get_number_of_transitions() const
+{
+  return number_of_transitions_;
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,109 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// romea
+#include "romea_localisation_utils/conversions/localisation_status_conversions.hpp"
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_status_publisher.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationStatusPublisher::LocalisationStatusPublisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name,
+  const double & keepalive_period)
+: pub_(nullptr),
+  timer_(nullptr),
+  aggregator_(),
+  msg_(),
+  number_of_publications_(0),
+  mutex_()
+{
+  if (keepalive_period <= 0) {
+    throw(std::runtime_error("Invalid status keepalive period"));
+  }
+
+  // transitions are rare, they must not be lost and must reach late subscribers
+  pub_ = node->create_publisher<Message>(
+    topic_name, rclcpp::QoS(1).reliable().transient_local());
+
+  auto period = std::chrono::duration<double>(keepalive_period);
+  timer_ = node->create_wall_timer(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(period),
+    std::bind(&LocalisationStatusPublisher::timer_callback_, this));
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationStatusPublisher::register_source(const std::string & source_name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return aggregator_.register_source(source_name);
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationStatusPublisher::update(
+  const size_t & source_id,
+  const core::LocalisationFSMState & fsm_state)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (aggregator_.update(source_id, fsm_state)) {
+    publish_();
+    // keepalive restarts from last transition
+    timer_->reset();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationStatusPublisher::timer_callback_()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  publish_();
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationStatusPublisher::publish_()
+{
+  to_ros_msg(aggregator_.get_status(), msg_);
+  pub_->publish(msg_);
+  ++number_of_publications_;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t LocalisationStatusPublisher::get_number_of_publications() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return number_of_publications_;
+}
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<LocalisationStatusPublisher> make_status_publisher(
+  std::shared_ptr<rclcpp::Node> node,
+  const std::string & topic_name)
+{
+  return std::make_unique<LocalisationStatusPublisher>(
+    node, topic_name, get_status_keepalive_period(node));
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,208 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_thread_pool.hpp"
+
+namespace
+{
+const size_t NUMBER_OF_BATCHES_PER_THREAD = 4;
+}
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationThreadPool::LocalisationThreadPool(const size_t & number_of_threads)
+: workers_(),
+  job_mutex_(),
+  mutex_(),
+  job_condition_(),
+  done_condition_(),
+  stop_(false),
+  job_generation_(0),
+  number_of_active_workers_(0),
+  task_(nullptr),
+  error_(nullptr),
+  size_(0),
+  batch_size_(0),
+  number_of_batches_(0),
+  next_batch_(0),
+  number_of_done_batches_(0),
+  has_error_(false)
+{
+  if (number_of_threads == 0) {
+    throw(std::runtime_error("Thread pool requires at least one thread"));
+  }
+
+  // calling thread is the first worker
+  for (size_t n = 1; n < number_of_threads; ++n) {
+    workers_.emplace_back(&LocalisationThreadPool::worker_loop_, this);
+  }
+}
+
+//-----------------------------------------------------------------------------
+LocalisationThreadPool::~LocalisationThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_condition_.notify_all();
+
+  for (auto & worker : workers_) {
+    worker.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+size_t LocalisationThreadPool::get_number_of_threads() const
+{
+  return workers_.size() + 1;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationThreadPool::parallel_for(
+  const size_t & size,
+  const Task & task,
+  const size_t & minimal_batch_size)
+{
+  if (size == 0) {
+    return;
+  }
+
+  size_t maximal_number_of_batches = get_number_of_threads() * NUMBER_OF_BATCHES_PER_THREAD;
+  size_t batch_size = std::max(
+    std::max<size_t>(minimal_batch_size, 1),
+    (size + maximal_number_of_batches - 1) / maximal_number_of_batches);
+  size_t number_of_batches = (size + batch_size - 1) / batch_size;
+
+  if (workers_.empty() || number_of_batches == 1) {
+    task(0, size);
+    return;
+  }
+
+  std::lock_guard<std::mutex> job_lock(job_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    size_ = size;
+    batch_size_ = batch_size;
+    number_of_batches_ = number_of_batches;
+    next_batch_.store(0);
+    number_of_done_batches_.store(0);
+    has_error_.store(false);
+    ++job_generation_;
+  }
+  job_condition_.notify_all();
+
+  run_batches_();
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_condition_.wait(
+      lock, [this]() {
+        return number_of_done_batches_.load() == number_of_batches_ &&
+        number_of_active_workers_ == 0;
+      });
+    task_ = nullptr;
+    std::swap(error, error_);
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationThreadPool::worker_loop_()
+{
+  uint64_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_condition_.wait(
+        lock, [&]() {
+          return stop_ || (job_generation_ != seen_generation && task_ != nullptr);
+        });
+
+      if (stop_) {
+        return;
+      }
+
+      seen_generation = job_generation_;
+      ++number_of_active_workers_;
+    }
+
+    run_batches_();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --number_of_active_workers_;
+    }
+    done_condition_.notify_all();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationThreadPool::run_batches_()
+{
+  while (true) {
+    size_t batch = next_batch_.fetch_add(1);
+    if (batch >= number_of_batches_) {
+      return;
+    }
+
+    // batches are still counted after a failure so that caller stops waiting,
+    // first exception is rethrown by caller
+    if (!has_error_.load()) {
+      size_t begin = batch * batch_size_;
+      size_t end = std::min(size_, begin + batch_size_);
+      try {
+        (*task_)(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        has_error_.store(true);
+      }
+    }
+
+    if (number_of_done_batches_.fetch_add(1) + 1 == number_of_batches_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_condition_.notify_all();
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<LocalisationThreadPool> make_thread_pool(std::shared_ptr<rclcpp::Node> node)
+{
+  return std::make_shared<LocalisationThreadPool>(get_thread_pool_number_of_threads(node));
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,119 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_updater_statistics.hpp"
+
+namespace
+{
+const double SMOOTHING_FACTOR = 0.05;
+const double BURST_PERIOD_RATIO = 0.25;
+const uint64_t MINIMAL_NUMBER_OF_MESSAGES_FOR_BURSTS = 10;
+}
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationUpdaterStatistics::LocalisationUpdaterStatistics()
+: snapshot_{0, 0., 0., 0., 0., 0, 0, 0},
+  last_arrival_time_(0),
+  last_stamp_(0),
+  mean_period_(0),
+  period_variance_(0),
+  burst_size_(0),
+  published_snapshot_(snapshot_)
+{
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationUpdaterStatistics::update(
+  const core::Duration & stamp,
+  const core::Duration & arrival_time)
+{
+  int64_t arrival_time_ns = arrival_time.count();
+  int64_t stamp_ns = stamp.count();
+  double delay = (arrival_time_ns - stamp_ns) * 1e-9;
+
+  if (snapshot_.number_of_messages == 0) {
+    snapshot_.mean_delay = delay;
+  } else {
+    double period = (arrival_time_ns - last_arrival_time_) * 1e-9;
+    if (snapshot_.number_of_messages == 1) {
+      mean_period_ = period;
+    } else {
+      // exponentially weighted mean and variance
+      double deviation = period - mean_period_;
+      mean_period_ += SMOOTHING_FACTOR * deviation;
+      period_variance_ = (1 - SMOOTHING_FACTOR) *
+        (period_variance_ + SMOOTHING_FACTOR * deviation * deviation);
+    }
+
+    if (snapshot_.number_of_messages >= MINIMAL_NUMBER_OF_MESSAGES_FOR_BURSTS &&
+      period < BURST_PERIOD_RATIO * mean_period_)
+    {
+      if (++burst_size_ == 1) {
+        ++snapshot_.number_of_bursts;
+      }
+      snapshot_.maximal_burst_size = std::max(snapshot_.maximal_burst_size, burst_size_ + 1);
+    } else {
+      burst_size_ = 0;
+    }
+
+    snapshot_.mean_delay += SMOOTHING_FACTOR * (delay - snapshot_.mean_delay);
+
+    // compared in integer nanoseconds, equal stamps are not out of order
+    if (stamp_ns < last_stamp_) {
+      ++snapshot_.number_of_out_of_order_messages;
+    }
+  }
+
+  last_arrival_time_ = arrival_time_ns;
+  last_stamp_ = std::max(last_stamp_, stamp_ns);
+  ++snapshot_.number_of_messages;
+  snapshot_.rate = mean_period_ > 0 ? 1 / mean_period_ : 0;
+  snapshot_.jitter = std::sqrt(period_variance_);
+  snapshot_.maximal_delay = std::max(snapshot_.maximal_delay, delay);
+  published_snapshot_.store(snapshot_);
+}
+
+//-----------------------------------------------------------------------------
+LocalisationUpdaterStatistics::Snapshot LocalisationUpdaterStatistics::get_snapshot() const
+{
+  return published_snapshot_.load();
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationUpdaterStatistics::append_to_report(core::DiagnosticReport & report) const
+{
+  Snapshot snapshot = get_snapshot();
+  report.info["arrival_rate"] = std::to_string(snapshot.rate);
+  report.info["arrival_jitter"] = std::to_string(snapshot.jitter);
+  report.info["mean_delay"] = std::to_string(snapshot.mean_delay);
+  report.info["maximal_delay"] = std::to_string(snapshot.maximal_delay);
+  report.info["bursts"] = std::to_string(snapshot.number_of_bursts);
+  report.info["maximal_burst_size"] = std::to_string(snapshot.maximal_burst_size);
+  report.info["out_of_order_messages"] =
+    std::to_string(snapshot.number_of_out_of_order_messages);
+}
+
+}  // namespace ros2
+}  // namespace romea
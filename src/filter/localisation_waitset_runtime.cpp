@@ -0,0 +1,138 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <memory>
+
+// romea
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+#include "romea_localisation_utils/filter/localisation_waitset_runtime.hpp"
+
+namespace romea
+{
+namespace ros2
+{
+
+//-----------------------------------------------------------------------------
+LocalisationWaitSetRuntime::LocalisationWaitSetRuntime(
+  std::shared_ptr<rclcpp::Node> node,
+  const int & cpu,
+  const std::chrono::nanoseconds & wait_timeout)
+: logger_(node->get_logger()),
+  context_(node->get_node_base_interface()->get_context()),
+  callback_group_(node->create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, false)),
+  wait_set_(),
+  takers_(),
+  samples_(),
+  cpu_(cpu),
+  wait_timeout_(wait_timeout),
+  stop_(false),
+  thread_()
+{
+}
+
+//-----------------------------------------------------------------------------
+LocalisationWaitSetRuntime::~LocalisationWaitSetRuntime()
+{
+  stop();
+}
+
+//-----------------------------------------------------------------------------
+rclcpp::CallbackGroup::SharedPtr LocalisationWaitSetRuntime::get_callback_group() const
+{
+  return callback_group_;
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationWaitSetRuntime::spin_some()
+{
+  auto result = wait_set_.wait(wait_timeout_);
+  if (result.kind() != rclcpp::WaitResultKind::Ready) {
+    return;
+  }
+
+  for (auto & take : takers_) {
+    take(samples_);
+  }
+
+  // stable sort keeps arrival order of samples with the same stamp
+  std::stable_sort(
+    samples_.begin(), samples_.end(), [](const Sample & lhs, const Sample & rhs) {
+      return lhs.stamp < rhs.stamp;
+    });
+
+  for (auto & sample : samples_) {
+    sample.process();
+  }
+  samples_.clear();
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationWaitSetRuntime::start()
+{
+  if (!thread_.joinable()) {
+    stop_ = false;
+    thread_ = std::thread(&LocalisationWaitSetRuntime::run_, this);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationWaitSetRuntime::stop()
+{
+  stop_ = true;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationWaitSetRuntime::run_()
+{
+  pin_thread_();
+  while (!stop_ && context_->is_valid()) {
+    spin_some();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void LocalisationWaitSetRuntime::pin_thread_()
+{
+  if (cpu_ < 0) {
+    return;
+  }
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu_, &cpu_set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0) {
+    RCLCPP_WARN(logger_, "Unable to pin wait set runtime thread on CPU %d", cpu_);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<LocalisationWaitSetRuntime> make_waitset_runtime(
+  std::shared_ptr<rclcpp::Node> node)
+{
+  return std::make_unique<LocalisationWaitSetRuntime>(
+    node,
+    get_runtime_cpu(node),
+    core::durationFromSecond(get_runtime_wait_timeout(node)));
+}
+
+}  // namespace ros2
+}  // namespace romea
@@ -0,0 +1,81 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <atomic>
+#include <thread>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/conversions/lever_arm_registry.hpp"
+
+
+//-----------------------------------------------------------------------------
+TEST(TestLeverArmRegistry, setAndFind)
+{
+  romea::ros2::LeverArmRegistry lever_arms;
+  lever_arms.set("gps_link", Eigen::Vector3d(1, 2, 3));
+  lever_arms.set("lidar_link", Eigen::Vector3d(4, 5, 6));
+  EXPECT_EQ(lever_arms.size(), 2u);
+
+  Eigen::Vector3d lever_arm(0, 0, 0);
+  EXPECT_TRUE(lever_arms.find("lidar_link", lever_arm));
+  EXPECT_DOUBLE_EQ(lever_arm.x(), 4);
+
+  lever_arm = Eigen::Vector3d(7, 7, 7);
+  EXPECT_FALSE(lever_arms.find("imu_link", lever_arm));
+  EXPECT_DOUBLE_EQ(lever_arm.x(), 7);
+
+  lever_arms.set("gps_link", Eigen::Vector3d(0.5, 0, 1.8));
+  EXPECT_EQ(lever_arms.size(), 2u);
+  EXPECT_TRUE(lever_arms.find("gps_link", lever_arm));
+  EXPECT_DOUBLE_EQ(lever_arm.z(), 1.8);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestLeverArmRegistry, calibrationUpdateIsAtomic)
+{
+  romea::ros2::LeverArmRegistry lever_arms;
+  lever_arms.set("gps_link", Eigen::Vector3d(0, 0, 0));
+
+  std::atomic<bool> stop(false);
+  std::thread writer([&]() {
+      for (int n = 1; n <= 2000; ++n) {
+        lever_arms.set("gps_link", Eigen::Vector3d(n, n, n));
+        lever_arms.set("frame" + std::to_string(n % 10), Eigen::Vector3d(n, 0, 0));
+      }
+      stop = true;
+    });
+
+  Eigen::Vector3d lever_arm;
+  while (!stop) {
+    ASSERT_TRUE(lever_arms.find("gps_link", lever_arm));
+    EXPECT_EQ(lever_arm.x(), lever_arm.y());
+    EXPECT_EQ(lever_arm.x(), lever_arm.z());
+  }
+  writer.join();
+
+  EXPECT_EQ(lever_arms.size(), 11u);
+  lever_arms.find("gps_link", lever_arm);
+  EXPECT_DOUBLE_EQ(lever_arm.x(), 2000);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_checkpoint.hpp"
+
+using std::chrono::seconds;
+
+class TestLocalisationCheckpoint : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::remove(filename.c_str());
+  }
+
+  const std::string filename = "/tmp/test_localisation_checkpoint.bin";
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpoint, noCheckpoint)
+{
+  romea::ros2::LocalisationCheckpoint checkpoint(filename, 12);
+  romea::ros2::LocalisationCheckpointData data;
+  EXPECT_FALSE(checkpoint.restore(seconds(10), seconds(10), data));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpoint, restoreLatestAfterRestart)
+{
+  Eigen::Vector3d state(1.0, 2.0, 0.5);
+  Eigen::Matrix3d covariance = Eigen::Matrix3d::Identity() * 0.1;
+
+  {
+    romea::ros2::LocalisationCheckpoint checkpoint(filename, 12);
+    checkpoint.save(seconds(1), 1, state, covariance);
+    checkpoint.save(seconds(2), 2, state * 2, covariance * 2);
+    checkpoint.save(seconds(3), 2, state * 3, covariance * 3);
+    EXPECT_EQ(checkpoint.get_number_of_saves(), 3u);
+  }
+
+  romea::ros2::LocalisationCheckpoint checkpoint(filename, 12);
+  EXPECT_EQ(checkpoint.get_number_of_saves(), 3u);
+
+  romea::ros2::LocalisationCheckpointData data;
+  ASSERT_TRUE(checkpoint.restore(seconds(4), seconds(10), data));
+  EXPECT_EQ(data.stamp, seconds(3));
+  EXPECT_EQ(data.fsm_state, 2u);
+  EXPECT_TRUE(data.state.isApprox(state * 3));
+  EXPECT_TRUE(data.covariance.isApprox(covariance * 3));
+
+  EXPECT_FALSE(checkpoint.restore(seconds(20), seconds(10), data));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpoint, particleSet)
+{
+  Eigen::MatrixXd particles = Eigen::MatrixXd::Random(3, 100);
+  Eigen::RowVectorXd weights = Eigen::RowVectorXd::Constant(100, 0.01);
+
+  romea::ros2::LocalisationCheckpoint checkpoint(filename, 400);
+  checkpoint.save(seconds(1), 2, particles, weights);
+
+  romea::ros2::LocalisationCheckpointData data;
+  ASSERT_TRUE(checkpoint.restore(seconds(1), seconds(1), data));
+  EXPECT_EQ(data.state.rows(), 3);
+  EXPECT_EQ(data.state.cols(), 100);
+  EXPECT_TRUE(data.state.isApprox(particles));
+  EXPECT_TRUE(data.covariance.isApprox(weights));
+
+  Eigen::MatrixXd too_many_particles = Eigen::MatrixXd::Zero(3, 200);
+  EXPECT_THROW(checkpoint.save(seconds(2), 2, too_many_particles, weights), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpoint, corruptedSlotFallsBackToPreviousCheckpoint)
+{
+  Eigen::Vector3d state(1.0, 2.0, 0.5);
+  Eigen::Matrix3d covariance = Eigen::Matrix3d::Identity();
+
+  {
+    romea::ros2::LocalisationCheckpoint checkpoint(filename, 12);
+    checkpoint.save(seconds(1), 1, state, covariance);
+    checkpoint.save(seconds(2), 1, state * 2, covariance);
+    checkpoint.save(seconds(3), 1, state * 3, covariance);
+  }
+
+  // slots are used alternately, last value of latest checkpoint is corrupted
+  {
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-static_cast<std::streamoff>(sizeof(double)), std::ios::end);
+    double value = 42;
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  romea::ros2::LocalisationCheckpoint checkpoint(filename, 12);
+  romea::ros2::LocalisationCheckpointData data;
+  ASSERT_TRUE(checkpoint.restore(seconds(3), seconds(10), data));
+  EXPECT_EQ(data.stamp, seconds(2));
+  EXPECT_TRUE(data.state.isApprox(state * 2));
+
+  // corrupted slot is overwritten first
+  checkpoint.save(seconds(4), 1, state * 4, covariance);
+  ASSERT_TRUE(checkpoint.restore(seconds(4), seconds(10), data));
+  EXPECT_EQ(data.stamp, seconds(4));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpoint, capacityChangeResetsFile)
+{
+  {
+    romea::ros2::LocalisationCheckpoint checkpoint(filename, 12);
+    checkpoint.save(seconds(1), 1, Eigen::Vector3d::Zero(), Eigen::Matrix3d::Identity());
+  }
+
+  romea::ros2::LocalisationCheckpoint checkpoint(filename, 24);
+  romea::ros2::LocalisationCheckpointData data;
+  EXPECT_FALSE(checkpoint.restore(seconds(1), seconds(10), data));
+  EXPECT_EQ(checkpoint.get_number_of_saves(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
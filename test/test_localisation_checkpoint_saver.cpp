@@ -0,0 +1,139 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <memory>
+#include <string>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_checkpoint_saver.hpp"
+#include "romea_localisation_utils/filter/localisation_parameters.hpp"
+
+//-----------------------------------------------------------------------------
+class TestLocalisationCheckpointSaver : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    std::remove(filename.c_str());
+    node = std::make_shared<rclcpp::Node>("test_localisation_checkpoint_saver");
+    romea::ros2::declare_checkpoint_parameters(node, filename, 1.0, 10.0);
+  }
+
+  romea::core::Duration now()
+  {
+    return romea::core::Duration(node->get_clock()->now().nanoseconds());
+  }
+
+  const std::string filename = "/tmp/test_localisation_checkpoint_saver.bin";
+  std::shared_ptr<rclcpp::Node> node;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpointSaver, filterStartsColdWithoutCheckpoint)
+{
+  auto checkpoint = romea::ros2::make_checkpoint(node, 12);
+
+  bool is_restored = false;
+  EXPECT_FALSE(
+    romea::ros2::restore_checkpoint(
+      node, *checkpoint,
+      [&is_restored](auto && ...) {is_restored = true;}));
+  EXPECT_FALSE(is_restored);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpointSaver, initialisingFilterIsNotSaved)
+{
+  auto checkpoint = romea::ros2::make_checkpoint(node, 12);
+  auto saver = romea::ros2::make_checkpoint_saver(
+    node, checkpoint,
+    [](auto && ...) {return false;});
+
+  EXPECT_FALSE(saver->save());
+  EXPECT_EQ(checkpoint->get_number_of_saves(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationCheckpointSaver, savedStateAndFsmAreRestored)
+{
+  romea::core::Duration stamp = now();
+
+  {
+    auto checkpoint = romea::ros2::make_checkpoint(node, 12);
+    auto saver = romea::ros2::make_checkpoint_saver(
+      node, checkpoint,
+      [stamp](
+        romea::core::Duration & snapshot_stamp,
+        romea::core::LocalisationFSMState & fsm_state,
+        Eigen::MatrixXd & state,
+        Eigen::MatrixXd & covariance)
+      {
+        snapshot_stamp = stamp;
+        fsm_state = romea::core::LocalisationFSMState::RUNNING;
+        state = Eigen::Vector3d(1.0, 2.0, 0.5);
+        covariance = Eigen::Matrix3d::Identity() * 0.1;
+        return true;
+      });
+
+    EXPECT_TRUE(saver->save());
+    EXPECT_EQ(checkpoint->get_number_of_saves(), 1u);
+  }
+
+  // restarted node
+  auto checkpoint = romea::ros2::make_checkpoint(node, 12);
+
+  romea::core::Duration restored_stamp;
+  romea::core::LocalisationFSMState restored_fsm_state = romea::core::LocalisationFSMState::INIT;
+  Eigen::MatrixXd restored_state;
+  EXPECT_TRUE(
+    romea::ros2::restore_checkpoint(
+      node, *checkpoint,
+      [&](
+        const romea::core::Duration & stamp,
+        const romea::core::LocalisationFSMState & fsm_state,
+        const Eigen::MatrixXd & state,
+        const Eigen::MatrixXd & /*covariance*/)
+      {
+        restored_stamp = stamp;
+        restored_fsm_state = fsm_state;
+        restored_state = state;
+      }));
+
+  EXPECT_EQ(restored_stamp, stamp);
+  EXPECT_EQ(restored_fsm_state, romea::core::LocalisationFSMState::RUNNING);
+  ASSERT_EQ(restored_state.rows(), 3);
+  EXPECT_DOUBLE_EQ(restored_state(1), 2.0);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,87 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_kld_sampling.hpp"
+
+
+//-----------------------------------------------------------------------------
+class TestKLDSampling : public ::testing::Test
+{
+public:
+  TestKLDSampling()
+  : kld(100, 5000, 0.05, 0.99, 0.5, 0.1)
+  {
+  }
+
+  romea::ros2::LocalisationKLDSampling kld;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestKLDSampling, numberOfParticlesIsBounded)
+{
+  EXPECT_TRUE(kld.is_adaptive());
+  EXPECT_EQ(kld.compute_number_of_particles(1), 100u);
+  EXPECT_EQ(kld.compute_number_of_particles(10000), 5000u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestKLDSampling, numberOfParticlesFromOccupiedBins)
+{
+  // reference values from Fox 2003 formula with z(0.99) = 2.326
+  EXPECT_NEAR(static_cast<double>(kld.compute_number_of_particles(10)), 217.0, 1.0);
+  EXPECT_NEAR(static_cast<double>(kld.compute_number_of_particles(50)), 750.0, 1.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestKLDSampling, countOccupiedBins)
+{
+  std::vector<double> x = {0.1, 0.2, 0.7, 0.1, -0.1};
+  std::vector<double> y = {0.1, 0.2, 0.2, 0.1, 0.1};
+  std::vector<double> yaw = {0.01, 0.02, 0.02, 0.15, 0.01};
+  EXPECT_EQ(kld.count_occupied_bins(x.data(), y.data(), yaw.data(), x.size()), 4u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestKLDSampling, tightPosteriorNeedsFewParticles)
+{
+  std::vector<double> x(5000, 1.0);
+  std::vector<double> y(5000, 2.0);
+  std::vector<double> yaw(5000, 0.3);
+  EXPECT_EQ(kld.compute_number_of_particles(x.data(), y.data(), yaw.data(), x.size()), 100u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestKLDSampling, throwWithInvalidRange)
+{
+  EXPECT_THROW(
+    romea::ros2::LocalisationKLDSampling(500, 100, 0.05, 0.99, 0.5, 0.1),
+    std::runtime_error);
+  EXPECT_THROW(
+    romea::ros2::LocalisationKLDSampling(100, 500, 0.05, 0.3, 0.5, 0.1),
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <memory>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "test_utils.hpp"
+#include "romea_localisation_utils/filter/localisation_lifecycle_updater_interface.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface.hpp"
+
+namespace
+{
+
+using Msg = romea_localisation_msgs::msg::ObservationPose2DStamped;
+using PoseUpdater = FakeUpdater<romea::core::ObservationPose>;
+using LifecycleInterface =
+  romea::ros2::LocalisationLifecycleUpdaterInterface<FakeFilter, PoseUpdater, Msg>;
+using Interface = romea::ros2::LocalisationUpdaterInterface<FakeFilter, PoseUpdater, Msg>;
+using CallbackReturn = LifecycleInterface::CallbackReturn;
+
+Msg::ConstSharedPtr make_msg(const long & milliseconds)
+{
+  auto msg = std::make_shared<Msg>();
+  msg->header.stamp.sec = static_cast<int32_t>(milliseconds / 1000);
+  msg->header.stamp.nanosec = static_cast<uint32_t>((milliseconds % 1000) * 1000000);
+  return msg;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+class TestLifecycleUpdaterInterface : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp_lifecycle::LifecycleNode>("test_lifecycle_updater_interface");
+    filter = std::make_shared<FakeFilter>();
+    interface = romea::ros2::make_lifecycle_updater_interface<LifecycleInterface>(node, "pose");
+  }
+
+  // updater heartbeat fails so that forwarding can be checked
+  std::unique_ptr<PoseUpdater> make_updater()
+  {
+    auto updater = std::make_unique<PoseUpdater>("pose", events);
+    updater->is_alive = false;
+    return updater;
+  }
+
+  std::shared_ptr<rclcpp_lifecycle::LifecycleNode> node;
+  std::shared_ptr<FakeFilter> filter;
+  EventLog events;
+  std::unique_ptr<LifecycleInterface> interface;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLifecycleUpdaterInterface, configureRequiresUpdaterAndFilter)
+{
+  EXPECT_EQ(interface->on_configure(nullptr, filter), CallbackReturn::FAILURE);
+  EXPECT_EQ(
+    interface->on_configure(make_updater(), nullptr),
+    CallbackReturn::FAILURE);
+  EXPECT_EQ(interface->on_activate(), CallbackReturn::FAILURE);
+  EXPECT_FALSE(interface->is_active());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLifecycleUpdaterInterface, messagesAreProcessedOnlyWhenActive)
+{
+  ASSERT_EQ(
+    interface->on_configure(make_updater(), filter),
+    CallbackReturn::SUCCESS);
+  interface->process_message(make_msg(1000));
+  EXPECT_TRUE(events.empty());
+
+  // inactive updater is always alive and reports nothing
+  EXPECT_TRUE(interface->heartbeat_callback(ms(1000)));
+  EXPECT_TRUE(interface->get_report().info.empty());
+
+  ASSERT_EQ(interface->on_activate(), CallbackReturn::SUCCESS);
+  EXPECT_TRUE(interface->is_active());
+  interface->process_message(make_msg(1100));
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].stamp, ms(1100));
+  EXPECT_FALSE(interface->heartbeat_callback(ms(1100)));
+  EXPECT_EQ(interface->get_report().info["fake"], "1");
+
+  ASSERT_EQ(interface->on_deactivate(), CallbackReturn::SUCCESS);
+  EXPECT_FALSE(interface->is_active());
+  interface->process_message(make_msg(1200));
+  EXPECT_EQ(events.size(), 1u);
+
+  // subscription and updater are kept across deactivation
+  ASSERT_EQ(interface->on_activate(), CallbackReturn::SUCCESS);
+  interface->process_message(make_msg(1300));
+  EXPECT_EQ(events.size(), 2u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLifecycleUpdaterInterface, cleanupReleasesUpdater)
+{
+  ASSERT_EQ(
+    interface->on_configure(make_updater(), filter),
+    CallbackReturn::SUCCESS);
+  ASSERT_EQ(interface->on_activate(), CallbackReturn::SUCCESS);
+  ASSERT_EQ(interface->on_cleanup(), CallbackReturn::SUCCESS);
+  EXPECT_FALSE(interface->is_active());
+
+  interface->process_message(make_msg(1000));
+  EXPECT_TRUE(events.empty());
+  EXPECT_EQ(interface->on_activate(), CallbackReturn::FAILURE);
+
+  ASSERT_EQ(
+    interface->on_configure(make_updater(), filter),
+    CallbackReturn::SUCCESS);
+  ASSERT_EQ(interface->on_activate(), CallbackReturn::SUCCESS);
+  interface->process_message(make_msg(1100));
+  EXPECT_EQ(events.size(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLifecycleUpdaterInterface, messageWithoutLoadedUpdaterIsIgnored)
+{
+  auto plain_node = std::make_shared<rclcpp::Node>("test_updater_interface");
+  Interface plain_interface(plain_node, "pose");
+  plain_interface.process_message(make_msg(1000));
+  EXPECT_TRUE(plain_interface.heartbeat_callback(ms(1000)));
+
+  plain_interface.load_updater(make_updater());
+  plain_interface.process_message(make_msg(1100));
+  EXPECT_TRUE(events.empty());
+
+  plain_interface.register_filter(filter);
+  plain_interface.process_message(make_msg(1200));
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].stamp, ms(1200));
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
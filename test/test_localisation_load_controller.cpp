@@ -0,0 +1,119 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_load_controller.hpp"
+
+using Clock = romea::ros2::LocalisationLoadController::Clock;
+using std::chrono::milliseconds;
+
+//-----------------------------------------------------------------------------
+class TestLoadController : public ::testing::Test
+{
+public:
+  TestLoadController()
+  : controller(0.5, milliseconds(100)),
+    twist_id(controller.register_updater("twist_updater", 10)),
+    pose_id(controller.register_updater("pose_updater", 1)),
+    now()
+  {
+  }
+
+  // simulates one second of 100 Hz twist messages and 10 Hz pose messages
+  size_t run_one_second(const Clock::duration & processing_time)
+  {
+    size_t number_of_accepted_twists = 0;
+    for (int n = 0; n < 100; ++n) {
+      now += milliseconds(10);
+      if (controller.accept(twist_id, now)) {
+        ++number_of_accepted_twists;
+        controller.record(twist_id, processing_time, now);
+      }
+      if (n % 10 == 0 && controller.accept(pose_id, now)) {
+        controller.record(pose_id, processing_time, now);
+      }
+    }
+    return number_of_accepted_twists;
+  }
+
+  romea::ros2::LocalisationLoadController controller;
+  size_t twist_id;
+  size_t pose_id;
+  Clock::time_point now;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLoadController, noDecimationUnderBudget)
+{
+  for (int n = 0; n < 5; ++n) {
+    EXPECT_EQ(run_one_second(milliseconds(1)), 100u);
+  }
+  EXPECT_DOUBLE_EQ(controller.get_shedding_level(), 0);
+  EXPECT_EQ(controller.get_number_of_decimated_messages(twist_id), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLoadController, decimationUnderOverload)
+{
+  // 10 ms per step for 110 steps per second is twice the 50% budget
+  for (int n = 0; n < 5; ++n) {
+    run_one_second(milliseconds(10));
+  }
+
+  size_t number_of_accepted_twists = run_one_second(milliseconds(10));
+  EXPECT_GT(controller.get_shedding_level(), 0.);
+  EXPECT_LT(number_of_accepted_twists, 50u);
+  EXPECT_GE(number_of_accepted_twists, 10u);
+  EXPECT_LT(controller.get_load(), 1.2);
+  EXPECT_GT(controller.get_number_of_decimated_messages(twist_id), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLoadController, decimationNeverGoesBelowMinimalRate)
+{
+  for (int n = 0; n < 5; ++n) {
+    run_one_second(milliseconds(100));
+  }
+
+  EXPECT_DOUBLE_EQ(controller.get_shedding_level(), 1.);
+  EXPECT_GE(run_one_second(milliseconds(100)), 10u);
+  EXPECT_EQ(controller.get_report().diagnostics.size(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLoadController, recoveryAfterOverload)
+{
+  for (int n = 0; n < 3; ++n) {
+    run_one_second(milliseconds(10));
+  }
+  for (int n = 0; n < 3; ++n) {
+    run_one_second(milliseconds(1));
+  }
+
+  EXPECT_DOUBLE_EQ(controller.get_shedding_level(), 0);
+  EXPECT_EQ(run_one_second(milliseconds(1)), 100u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
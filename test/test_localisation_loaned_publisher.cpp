@@ -0,0 +1,100 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+#include <memory>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_loaned_publisher.hpp"
+
+using RangeMsg = romea_localisation_msgs::msg::ObservationRange;
+using RangeStampedMsg = romea_localisation_msgs::msg::ObservationRangeStamped;
+
+//-----------------------------------------------------------------------------
+class TestLoanedPublisher : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp::Node>("test_loaned_publisher");
+  }
+
+  std::shared_ptr<rclcpp::Node> node;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLoanedPublisher, onlyPayloadsCanBeLoaned)
+{
+  EXPECT_TRUE(rosidl_generator_traits::is_plain<RangeMsg>::value);
+  EXPECT_TRUE(
+    rosidl_generator_traits::is_plain<romea_localisation_msgs::msg::ObservationPose2D>::value);
+  EXPECT_TRUE(
+    rosidl_generator_traits::is_plain<romea_localisation_msgs::msg::ObservationTwist2D>::value);
+  EXPECT_FALSE(rosidl_generator_traits::is_plain<RangeStampedMsg>::value);
+
+  romea::ros2::LocalisationLoanedPublisher<RangeStampedMsg> stamped_pub(
+    node, "range_stamped", rclcpp::SystemDefaultsQoS());
+  EXPECT_FALSE(stamped_pub.is_loaning_messages());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLoanedPublisher, payloadIsPublished)
+{
+  RangeMsg::SharedPtr received;
+  auto sub = node->create_subscription<RangeMsg>(
+    "range", rclcpp::SystemDefaultsQoS(),
+    [&received](RangeMsg::SharedPtr msg) {received = msg;});
+
+  auto pub = romea::ros2::make_loaned_publisher<RangeMsg>(
+    node, "range", rclcpp::SystemDefaultsQoS());
+
+  romea::core::ObservationRange observation;
+  observation.Y() = 12.5;
+  observation.R() = 0.04;
+  observation.initiatorPosition = Eigen::Vector3d(1, 2, 3);
+  observation.responderPosition = Eigen::Vector3d(4, 5, 6);
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!received && std::chrono::steady_clock::now() < deadline) {
+    pub->publish(observation);
+    rclcpp::spin_some(node);
+  }
+
+  ASSERT_TRUE(received);
+  EXPECT_DOUBLE_EQ(received->range, 12.5);
+  EXPECT_DOUBLE_EQ(received->range_std, 0.2);
+  EXPECT_DOUBLE_EQ(received->initiator_antenna_position.z, 3);
+  EXPECT_DOUBLE_EQ(received->responder_antenna_position.x, 4);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
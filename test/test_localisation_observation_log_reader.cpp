@@ -0,0 +1,207 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_observation_log_reader.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+#include "romea_localisation_utils/filter/localisation_observation_replayer.hpp"
+
+using std::chrono::milliseconds;
+
+namespace
+{
+
+struct CourseObservation
+{
+  double & Y() {return Y_;}
+  const double & Y() const {return Y_;}
+  double & R() {return R_;}
+  const double & R() const {return R_;}
+
+  double Y_ = 0;
+  double R_ = 0;
+};
+
+struct CourseUpdater
+{
+  using Observation = CourseObservation;
+
+  void update(
+    const romea::core::Duration & duration,
+    const Observation & observation,
+    std::vector<std::pair<int64_t, double>> & updates,
+    int &)
+  {
+    updates.emplace_back(duration.count(), observation.Y());
+  }
+};
+
+struct Filter
+{
+  template<typename UpdateFunction>
+  void process(const romea::core::Duration & duration, UpdateFunction && updateFunction)
+  {
+    int state = 0;
+    updateFunction(duration, updates, state);
+  }
+
+  std::vector<std::pair<int64_t, double>> updates;
+};
+
+void write_log(
+  const std::string & filename,
+  const std::vector<std::string> & updater_names,
+  const std::vector<std::pair<int, int>> & stamps_and_updaters,
+  const bool & ring_mode = false,
+  const size_t & capacity = 100)
+{
+  std::remove(filename.c_str());
+  romea::ros2::LocalisationObservationRecorder recorder(filename, capacity, ring_mode);
+  for (const auto & updater_name : updater_names) {
+    recorder.register_updater(updater_name);
+  }
+
+  CourseObservation course;
+  for (const auto & [stamp, updater_id] : stamps_and_updaters) {
+    course.Y() = stamp;
+    recorder.record(updater_id, milliseconds(stamp), course);
+  }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationLogReader, indexByStampAndUpdater)
+{
+  const std::string filename = "/tmp/test_observation_log_reader_index.bin";
+  write_log(filename, {"course_updater", "attitude_updater"}, {{10, 0}, {30, 1}, {20, 0}, {30, 0}});
+
+  romea::ros2::LocalisationObservationLogReader reader(filename);
+  ASSERT_EQ(reader.size(), 4u);
+  EXPECT_EQ(reader.find_updater("attitude_updater"), 1u);
+  EXPECT_EQ(reader.find_updater("pose_updater"), reader.NOT_FOUND);
+  EXPECT_EQ(reader.get_start_stamp(), milliseconds(10));
+  EXPECT_EQ(reader.get_end_stamp(), milliseconds(30));
+
+  EXPECT_DOUBLE_EQ(reader.get_record(1).Y[0], 20);
+  // same stamp, recording order is kept
+  EXPECT_EQ(reader.get_record(2).updater_id, 1);
+  EXPECT_EQ(reader.get_record(3).updater_id, 0);
+
+  EXPECT_EQ(reader.get_updater_records(0), (std::vector<size_t>{0, 1, 3}));
+  EXPECT_EQ(reader.get_updater_records(1), (std::vector<size_t>{2}));
+  EXPECT_EQ(reader.lower_bound(milliseconds(15)), 1u);
+  EXPECT_EQ(reader.lower_bound(milliseconds(40)), 4u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationLogReader, ringModeAndIncompleteRecord)
+{
+  const std::string filename = "/tmp/test_observation_log_reader_ring.bin";
+  std::vector<std::pair<int, int>> stamps_and_updaters;
+  for (int n = 0; n < 10; ++n) {
+    stamps_and_updaters.emplace_back(n, 0);
+  }
+  write_log(filename, {"course_updater"}, stamps_and_updaters, true, 4);
+
+  // simulates a crash while record 9 was written
+  {
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(romea::ros2::ObservationLogHeader) + sizeof(romea::ros2::ObservationRecord));
+    uint64_t sequence = 0;
+    file.write(reinterpret_cast<const char *>(&sequence), sizeof(sequence));
+  }
+
+  romea::ros2::LocalisationObservationLogReader reader(filename);
+  ASSERT_EQ(reader.size(), 3u);
+  EXPECT_EQ(reader.get_start_stamp(), milliseconds(6));
+  EXPECT_EQ(reader.get_end_stamp(), milliseconds(8));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationLogReader, invalidLog)
+{
+  const std::string filename = "/tmp/test_observation_log_reader_invalid.bin";
+  {
+    std::ofstream file(filename);
+    file << std::string(4096, 'x');
+  }
+
+  EXPECT_THROW(romea::ros2::LocalisationObservationLogReader{filename}, std::runtime_error);
+  EXPECT_THROW(
+    romea::ros2::LocalisationObservationLogReader{"/tmp/does_not_exist.bin"},
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationLogReader, replayMergedLogsInWindow)
+{
+  std::vector<std::string> filenames = {
+    "/tmp/test_observation_log_reader_replay0.bin",
+    "/tmp/test_observation_log_reader_replay1.bin",
+    "/tmp/test_observation_log_reader_replay2.bin"};
+
+  write_log(filenames[0], {"course_updater"}, {{0, 0}, {30, 0}, {60, 0}});
+  write_log(filenames[1], {"pose_updater", "course_updater"}, {{10, 1}, {40, 0}, {70, 1}});
+  write_log(filenames[2], {"course_updater"}, {{20, 0}, {50, 0}, {80, 0}});
+
+  romea::ros2::LocalisationThreadPool thread_pool(3);
+  auto readers = romea::ros2::open_observation_logs(filenames, thread_pool);
+  ASSERT_EQ(readers.size(), 3u);
+
+  auto filter = std::make_shared<Filter>();
+  romea::ros2::LocalisationObservationReplayer<Filter> replayer(filter);
+  replayer.register_updater("course_updater", std::make_unique<CourseUpdater>());
+
+  std::vector<const romea::ros2::LocalisationObservationLogReader *> views;
+  for (const auto & reader : readers) {
+    views.push_back(reader.get());
+  }
+
+  EXPECT_EQ(replayer.replay(views, milliseconds(10), milliseconds(80)), 6u);
+  EXPECT_EQ(replayer.get_number_of_skipped_records(), 1u);
+
+  std::vector<std::pair<int64_t, double>> expected;
+  for (int stamp : {10, 20, 30, 50, 60, 70}) {
+    expected.emplace_back(romea::core::Duration(milliseconds(stamp)).count(), stamp);
+  }
+  EXPECT_EQ(filter->updates, expected);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationLogReader, openLogsReportsErrors)
+{
+  romea::ros2::LocalisationThreadPool thread_pool(2);
+  EXPECT_THROW(
+    romea::ros2::open_observation_logs({"/tmp/does_not_exist.bin"}, thread_pool),
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
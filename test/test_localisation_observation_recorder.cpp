@@ -0,0 +1,241 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// eigen
+#include "Eigen/Core"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_observation_recorder.hpp"
+
+namespace
+{
+
+struct PositionObservation
+{
+  Eigen::Vector2d & Y() {return Y_;}
+  const Eigen::Vector2d & Y() const {return Y_;}
+  Eigen::Matrix2d & R() {return R_;}
+  const Eigen::Matrix2d & R() const {return R_;}
+
+  Eigen::Vector2d Y_;
+  Eigen::Matrix2d R_;
+  Eigen::Vector3d levelArm;
+};
+
+struct CourseObservation
+{
+  double & Y() {return Y_;}
+  const double & Y() const {return Y_;}
+  double & R() {return R_;}
+  const double & R() const {return R_;}
+
+  double Y_;
+  double R_;
+};
+
+std::vector<char> read_file(const std::string & filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+}
+
+const romea::ros2::ObservationLogHeader & get_header(const std::vector<char> & data)
+{
+  return *reinterpret_cast<const romea::ros2::ObservationLogHeader *>(data.data());
+}
+
+const romea::ros2::ObservationRecord & get_record(
+  const std::vector<char> & data,
+  const size_t & slot)
+{
+  return reinterpret_cast<const romea::ros2::ObservationRecord *>(
+    data.data() + sizeof(romea::ros2::ObservationLogHeader))[slot];
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationRecorder, recordConversions)
+{
+  PositionObservation position;
+  position.Y() << 1.0, 2.0;
+  position.R() << 0.1, 0.01, 0.02, 0.2;
+  position.levelArm << 0.5, 0.0, 1.5;
+
+  romea::ros2::ObservationRecord record;
+  romea::ros2::to_record(std::chrono::milliseconds(1500), 3, position, record);
+  EXPECT_EQ(record.stamp, 1500000000);
+  EXPECT_EQ(record.updater_id, 3);
+  EXPECT_EQ(record.dimension, 2);
+
+  PositionObservation restored;
+  romea::ros2::from_record(record, restored);
+  EXPECT_TRUE(restored.Y().isApprox(position.Y()));
+  EXPECT_TRUE(restored.R().isApprox(position.R()));
+  EXPECT_TRUE(restored.levelArm.isApprox(position.levelArm));
+
+  CourseObservation course{0.3, 0.01};
+  romea::ros2::to_record(std::chrono::milliseconds(10), 0, course, record);
+  EXPECT_EQ(record.dimension, 1);
+
+  CourseObservation restored_course{0, 0};
+  romea::ros2::from_record(record, restored_course);
+  EXPECT_DOUBLE_EQ(restored_course.Y(), 0.3);
+  EXPECT_DOUBLE_EQ(restored_course.R(), 0.01);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationRecorder, appendMode)
+{
+  const std::string filename = "/tmp/test_observation_recorder_append.bin";
+  std::remove(filename.c_str());
+  {
+    romea::ros2::LocalisationObservationRecorder recorder(filename, 4, false);
+    EXPECT_EQ(recorder.register_updater("position_updater"), 0);
+    EXPECT_EQ(recorder.register_updater("course_updater"), 1);
+
+    CourseObservation course{0.0, 0.01};
+    for (int n = 0; n < 6; ++n) {
+      course.Y() = n;
+      recorder.record(1, std::chrono::milliseconds(n), course);
+    }
+
+    EXPECT_EQ(recorder.get_number_of_records(), 4u);
+    EXPECT_EQ(recorder.get_number_of_dropped_records(), 2u);
+    EXPECT_EQ(recorder.get_report().diagnostics.size(), 1u);
+  }
+
+  std::vector<char> data = read_file(filename);
+  ASSERT_EQ(
+    data.size(),
+    sizeof(romea::ros2::ObservationLogHeader) + 4 * sizeof(romea::ros2::ObservationRecord));
+
+  const auto & header = get_header(data);
+  EXPECT_EQ(std::memcmp(header.magic, romea::ros2::OBSERVATION_LOG_MAGIC, 8), 0);
+  EXPECT_EQ(header.capacity, 4u);
+  EXPECT_EQ(header.number_of_updaters, 2u);
+  EXPECT_STREQ(header.updater_names[1], "course_updater");
+
+  for (size_t n = 0; n < 4; ++n) {
+    EXPECT_EQ(get_record(data, n).sequence, n + 1);
+    EXPECT_EQ(get_record(data, n).updater_id, 1);
+    EXPECT_DOUBLE_EQ(get_record(data, n).Y[0], n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationRecorder, ringModeKeepsLatestRecords)
+{
+  const std::string filename = "/tmp/test_observation_recorder_ring.bin";
+  std::remove(filename.c_str());
+  {
+    romea::ros2::LocalisationObservationRecorder recorder(filename, 4, true);
+    recorder.register_updater("course_updater");
+
+    CourseObservation course{0.0, 0.01};
+    for (int n = 0; n < 10; ++n) {
+      course.Y() = n;
+      recorder.record(0, std::chrono::milliseconds(n), course);
+    }
+
+    EXPECT_EQ(recorder.get_number_of_records(), 10u);
+    EXPECT_EQ(recorder.get_number_of_dropped_records(), 0u);
+  }
+
+  std::vector<char> data = read_file(filename);
+  EXPECT_EQ(get_header(data).number_of_records, 10u);
+  for (size_t n = 6; n < 10; ++n) {
+    EXPECT_EQ(get_record(data, n % 4).sequence, n + 1);
+    EXPECT_DOUBLE_EQ(get_record(data, n % 4).Y[0], n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationRecorder, concurrentWriters)
+{
+  const std::string filename = "/tmp/test_observation_recorder_concurrent.bin";
+  std::remove(filename.c_str());
+  {
+    romea::ros2::LocalisationObservationRecorder recorder(filename, 4000, false);
+
+    std::vector<std::thread> writers;
+    for (uint16_t id = 0; id < 4; ++id) {
+      writers.emplace_back(
+        [&recorder, id]() {
+          uint16_t updater_id = recorder.register_updater("updater" + std::to_string(id));
+          CourseObservation course{0.0, 0.01};
+          for (int n = 0; n < 1000; ++n) {
+            course.Y() = n;
+            recorder.record(updater_id, std::chrono::milliseconds(n), course);
+          }
+        });
+    }
+
+    for (auto & writer : writers) {
+      writer.join();
+    }
+  }
+
+  std::vector<char> data = read_file(filename);
+  std::vector<size_t> counts(4, 0);
+  for (size_t n = 0; n < 4000; ++n) {
+    const auto & record = get_record(data, n);
+    EXPECT_EQ(record.sequence, n + 1);
+    ASSERT_LT(record.updater_id, 4);
+    ++counts[record.updater_id];
+  }
+
+  for (const auto & count : counts) {
+    EXPECT_EQ(count, 1000u);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestObservationRecorder, existingLogIsNotOverwritten)
+{
+  const std::string filename = "/tmp/test_observation_recorder_existing.bin";
+  std::remove(filename.c_str());
+  {
+    romea::ros2::LocalisationObservationRecorder recorder(filename, 4, false);
+    recorder.register_updater("course_updater");
+    recorder.record(0, std::chrono::milliseconds(1), CourseObservation{1.0, 0.01});
+  }
+
+  EXPECT_THROW(
+    romea::ros2::LocalisationObservationRecorder(filename, 4, false),
+    std::runtime_error);
+
+  std::vector<char> data = read_file(filename);
+  EXPECT_EQ(get_header(data).number_of_records, 1u);
+  EXPECT_STREQ(get_header(data).updater_names[0], "course_updater");
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
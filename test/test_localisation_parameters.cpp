@@ -88,6 +88,13 @@ TEST_F(TestLocalisationFilterParams, checkGetFilterNumberOfParticles)
   EXPECT_EQ(romea::ros2::get_filter_number_of_particles(node), 200u);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetThreadPoolNumberOfThreads)
+{
+  romea::ros2::declare_thread_pool_number_of_threads(node, 1);
+  EXPECT_EQ(romea::ros2::get_thread_pool_number_of_threads(node), 4u);
+}
+
 //-----------------------------------------------------------------------------
 TEST_F(TestLocalisationFilterParams, checkGetFilterStatePoolSize)
 {
@@ -95,6 +102,39 @@ TEST_F(TestLocalisationFilterParams, checkGetFilterStatePoolSize)
   EXPECT_EQ(romea::ros2::get_filter_state_pool_size(node), 1000u);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetAutoFilterStatePoolSize)
+{
+  romea::ros2::declare_filter_state_pool_size(node);
+  romea::ros2::declare_filter_maximal_observation_latency(node, 0.5);
+  romea::ros2::declare_updater_minimal_rate(node, "angular_speed_updater", 20u);
+  romea::ros2::declare_updater_minimal_rate(node, "position_updater", 20u);
+  node->set_parameter(rclcpp::Parameter("filter.state_pool_size", 0));
+
+  EXPECT_EQ(
+    romea::ros2::get_filter_state_pool_size(node, {"angular_speed_updater", "position_updater"}),
+    romea::ros2::compute_filter_state_pool_size({10, 1}, 0.2));
+  EXPECT_EQ(
+    romea::ros2::get_filter_state_pool_size(node, {"angular_speed_updater"}),
+    romea::ros2::compute_filter_state_pool_size({10}, 0.2));
+  EXPECT_THROW(romea::ros2::get_filter_state_pool_size(node), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetFilterMaximalObservationLatency)
+{
+  romea::ros2::declare_filter_maximal_observation_latency(node, 0.5);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_filter_maximal_observation_latency(node), 0.2);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkComputeFilterStatePoolSize)
+{
+  EXPECT_EQ(romea::ros2::compute_filter_state_pool_size({10, 10, 1}, 1.0), 33u);
+  EXPECT_THROW(romea::ros2::compute_filter_state_pool_size({}, 1.0), std::runtime_error);
+  EXPECT_THROW(romea::ros2::compute_filter_state_pool_size({10}, 0.0), std::runtime_error);
+}
+
 //-----------------------------------------------------------------------------
 TEST_F(TestLocalisationFilterParams, checkGetUpdaterTriggerMode)
 {
@@ -147,6 +187,140 @@ TEST_F(TestLocalisationFilterParams, checkGetUpdaterEmptyMahalanobisDistance)
     romea::ros2::get_updater_mahalanobis_distance_rejection_threshold(node, "bar"), 3);
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetUpdaterMaximalBatchSize)
+{
+  romea::ros2::declare_updater_maximal_batch_size(node, "range_updater", 1);
+  EXPECT_EQ(romea::ros2::get_updater_maximal_batch_size(node, "range_updater"), 8u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetUpdaterBatchWindow)
+{
+  romea::ros2::declare_updater_batch_window(node, "range_updater", 0.0);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_updater_batch_window(node, "range_updater"), 0.05);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetUpdaterPriority)
+{
+  romea::ros2::declare_updater_priority(node, "position_updater", 0);
+  EXPECT_EQ(romea::ros2::get_updater_priority(node, "position_updater"), 10);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetUpdaterPreintegrationInterval)
+{
+  romea::ros2::declare_updater_preintegration_interval(node, "linear_speeds_updater", 0.0);
+  EXPECT_DOUBLE_EQ(
+    romea::ros2::get_updater_preintegration_interval(node, "linear_speeds_updater"), 0.1);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetUpdaterRangeAnchors)
+{
+  romea::ros2::declare_updater_range_anchors(node, "range_updater");
+  auto anchors = romea::ros2::get_updater_range_anchors(node, "range_updater");
+  EXPECT_EQ(anchors.size(), 2u);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A2").x(), 50.0);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A2").z(), 2.5);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetUpdaterRangeAnchorsFromFile)
+{
+  romea::ros2::declare_updater_range_anchors(node, "foo");
+  node->set_parameter(
+    rclcpp::Parameter("foo.anchors_filename", std::string(TEST_DIR) + "/test_range_anchors.txt"));
+  auto anchors = romea::ros2::get_updater_range_anchors(node, "foo");
+  EXPECT_EQ(anchors.size(), 3u);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A3").y(), 30.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetExtrapolationRate)
+{
+  romea::ros2::declare_extrapolation_rate(node, 50.0);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_extrapolation_rate(node), 100.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetExtrapolationMaximalHorizon)
+{
+  romea::ros2::declare_extrapolation_maximal_horizon(node, 1.0);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_extrapolation_maximal_horizon(node), 0.5);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetDispatcherParameters)
+{
+  romea::ros2::declare_dispatcher_parameters(node, 8, 0.1);
+  EXPECT_EQ(romea::ros2::get_dispatcher_maximal_queue_size(node), 32u);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_dispatcher_maximal_delay(node), 0.05);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetLoadControllerParameters)
+{
+  romea::ros2::declare_load_controller_parameters(node, 0.8, 1.0);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_load_controller_cpu_budget(node), 0.5);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_load_controller_period(node), 2.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetSequencerReorderWindow)
+{
+  romea::ros2::declare_sequencer_reorder_window(node, 0.0);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_sequencer_reorder_window(node), 0.3);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetRuntimeParameters)
+{
+  romea::ros2::declare_runtime_parameters(node, -1, 0.1);
+  EXPECT_EQ(romea::ros2::get_runtime_cpu(node), 2);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_runtime_wait_timeout(node), 0.1);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetRecorderParameters)
+{
+  romea::ros2::declare_recorder_parameters(node, "observations.bin", 1000, true);
+  EXPECT_EQ(romea::ros2::get_recorder_filename(node), "/tmp/observations.bin");
+  EXPECT_EQ(romea::ros2::get_recorder_capacity(node), 360000u);
+  EXPECT_TRUE(romea::ros2::get_recorder_ring_mode(node));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetCheckpointParameters)
+{
+  romea::ros2::declare_checkpoint_parameters(node, "checkpoint.bin", 1.0, 10.0);
+  EXPECT_EQ(romea::ros2::get_checkpoint_filename(node), "/tmp/checkpoint.bin");
+  EXPECT_DOUBLE_EQ(romea::ros2::get_checkpoint_period(node), 0.5);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_checkpoint_maximal_age(node), 10.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetStatusKeepalivePeriod)
+{
+  romea::ros2::declare_status_keepalive_period(node, 1.0);
+  EXPECT_DOUBLE_EQ(romea::ros2::get_status_keepalive_period(node), 5.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestLocalisationFilterParams, checkGetLeverArms)
+{
+  romea::ros2::declare_lever_arms(node);
+  auto lever_arms = romea::ros2::get_lever_arms(node);
+  EXPECT_EQ(lever_arms.size(), 2u);
+
+  Eigen::Vector3d lever_arm;
+  EXPECT_TRUE(lever_arms.find("gps_link", lever_arm));
+  EXPECT_DOUBLE_EQ(lever_arm.x(), 0.5);
+  EXPECT_DOUBLE_EQ(lever_arm.z(), 1.8);
+  EXPECT_FALSE(lever_arms.find("imu_link", lever_arm));
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -0,0 +1,124 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cmath>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_pose_extrapolator.hpp"
+
+
+//-----------------------------------------------------------------------------
+class TestPoseExtrapolator : public ::testing::Test
+{
+public:
+  TestPoseExtrapolator()
+  : extrapolator(romea::core::durationFromSecond(0.5)),
+    pose(),
+    twist()
+  {
+  }
+
+  void SetUp()override
+  {
+    pose.position.x() = 1;
+    pose.position.y() = 2;
+    pose.yaw = M_PI_2;
+    pose.covariance = Eigen::Matrix3d::Identity() * 0.01;
+    twist.linearSpeeds.x() = 2;
+    twist.linearSpeeds.y() = 0;
+    twist.angularSpeed = 0;
+    twist.covariance = Eigen::Matrix3d::Identity() * 0.1;
+  }
+
+  romea::ros2::LocalisationPoseExtrapolator extrapolator;
+  romea::core::Pose2D pose;
+  romea::core::Twist2D twist;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseExtrapolator, noPoseAvailable)
+{
+  romea::core::Pose2D extrapolated_pose;
+  EXPECT_FALSE(extrapolator.extrapolate(romea::core::durationFromSecond(1), extrapolated_pose));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseExtrapolator, noTwistAvailable)
+{
+  romea::core::Pose2D extrapolated_pose;
+  extrapolator.update_pose(romea::core::durationFromSecond(1), pose);
+  EXPECT_TRUE(extrapolator.extrapolate(romea::core::durationFromSecond(1.1), extrapolated_pose));
+  EXPECT_DOUBLE_EQ(extrapolated_pose.position.x(), pose.position.x());
+  EXPECT_DOUBLE_EQ(extrapolated_pose.position.y(), pose.position.y());
+  EXPECT_DOUBLE_EQ(extrapolated_pose.yaw, pose.yaw);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseExtrapolator, straightLine)
+{
+  romea::core::Pose2D extrapolated_pose;
+  extrapolator.update_pose(romea::core::durationFromSecond(1), pose);
+  extrapolator.update_twist(romea::core::durationFromSecond(1), twist);
+  EXPECT_TRUE(extrapolator.extrapolate(romea::core::durationFromSecond(1.1), extrapolated_pose));
+  EXPECT_NEAR(extrapolated_pose.position.x(), 1.0, 1e-9);
+  EXPECT_NEAR(extrapolated_pose.position.y(), 2.2, 1e-9);
+  EXPECT_NEAR(extrapolated_pose.yaw, M_PI_2, 1e-9);
+  EXPECT_GT(extrapolated_pose.covariance(0, 0), pose.covariance(0, 0));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseExtrapolator, horizonIsBounded)
+{
+  romea::core::Pose2D extrapolated_pose;
+  extrapolator.update_pose(romea::core::durationFromSecond(1), pose);
+  extrapolator.update_twist(romea::core::durationFromSecond(1), twist);
+  EXPECT_TRUE(extrapolator.extrapolate(romea::core::durationFromSecond(1.5), extrapolated_pose));
+  EXPECT_NEAR(extrapolated_pose.position.y(), 3.0, 1e-9);
+  EXPECT_FALSE(extrapolator.extrapolate(romea::core::durationFromSecond(10), extrapolated_pose));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseExtrapolator, staleTwistIsIgnored)
+{
+  romea::core::Pose2D extrapolated_pose;
+  extrapolator.update_twist(romea::core::durationFromSecond(1), twist);
+  extrapolator.update_pose(romea::core::durationFromSecond(2), pose);
+  EXPECT_TRUE(extrapolator.extrapolate(romea::core::durationFromSecond(2.1), extrapolated_pose));
+  EXPECT_DOUBLE_EQ(extrapolated_pose.position.x(), pose.position.x());
+  EXPECT_DOUBLE_EQ(extrapolated_pose.position.y(), pose.position.y());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseExtrapolator, circularArc)
+{
+  pose.yaw = 0;
+  twist.linearSpeeds.x() = 1;
+  twist.angularSpeed = M_PI_2;
+
+  auto extrapolated_pose = romea::ros2::LocalisationPoseExtrapolator::extrapolate(pose, twist, 1);
+  EXPECT_NEAR(extrapolated_pose.position.x(), 1 + 2 / M_PI, 1e-9);
+  EXPECT_NEAR(extrapolated_pose.position.y(), 2 + 2 / M_PI, 1e-9);
+  EXPECT_NEAR(extrapolated_pose.yaw, M_PI_2, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,211 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <memory>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "test_utils.hpp"
+#include "romea_localisation_utils/filter/localisation_pose_twist_updater_interface.hpp"
+
+namespace
+{
+
+using PoseUpdater = FakeUpdater<romea::core::ObservationPose>;
+using TwistUpdater = FakeUpdater<romea::core::ObservationTwist>;
+using UpdaterInterface = romea::ros2::LocalisationPoseTwistUpdaterInterface<
+  FakeFilter, PoseUpdater, TwistUpdater>;
+
+template<typename Msg>
+typename Msg::ConstSharedPtr make_msg(const long & milliseconds)
+{
+  auto msg = std::make_shared<Msg>();
+  msg->header.stamp.sec = static_cast<int32_t>(milliseconds / 1000);
+  msg->header.stamp.nanosec = static_cast<uint32_t>((milliseconds % 1000) * 1000000);
+  return msg;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+class TestPoseTwistUpdaterInterface : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp::Node>("test_pose_twist_updater_interface");
+    filter = std::make_shared<FakeFilter>();
+    events.clear();
+
+    interface = romea::ros2::make_pose_twist_updater_interface<UpdaterInterface>(
+      node, "pose", "twist", filter,
+      std::make_unique<PoseUpdater>("pose", events, filter),
+      std::make_unique<TwistUpdater>("twist", events, filter));
+  }
+
+  void process_pose(const long & milliseconds)
+  {
+    interface->process_pose_message(make_msg<UpdaterInterface::PoseMsg>(milliseconds));
+  }
+
+  void process_twist(const long & milliseconds)
+  {
+    interface->process_twist_message(make_msg<UpdaterInterface::TwistMsg>(milliseconds));
+  }
+
+  std::shared_ptr<rclcpp::Node> node;
+  std::shared_ptr<FakeFilter> filter;
+  EventLog events;
+  std::unique_ptr<UpdaterInterface> interface;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, equalStampsAreAppliedInOneStep)
+{
+  process_pose(1000);
+  EXPECT_TRUE(events.empty());
+
+  process_twist(1000);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].updater, "twist");
+  EXPECT_EQ(events[1].updater, "pose");
+  EXPECT_EQ(events[0].stamp, ms(1000));
+  EXPECT_EQ(events[1].stamp, ms(1000));
+  EXPECT_EQ(events[0].step, events[1].step);
+  EXPECT_EQ(filter->number_of_steps, 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, olderPendingPoseIsReleasedByNewerTwist)
+{
+  process_pose(1000);
+  process_twist(1100);
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].updater, "pose");
+  EXPECT_EQ(events[0].stamp, ms(1000));
+
+  // twist stays pending until a pose with same stamp arrives
+  process_pose(1100);
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[1].updater, "twist");
+  EXPECT_EQ(events[2].updater, "pose");
+  EXPECT_EQ(events[1].step, events[2].step);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, olderPendingTwistIsReleasedByNewerPose)
+{
+  process_twist(1000);
+  process_pose(1100);
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].updater, "twist");
+  EXPECT_EQ(events[0].stamp, ms(1000));
+
+  interface->flush();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[1].updater, "pose");
+  EXPECT_EQ(events[1].stamp, ms(1100));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, olderMessageIsProcessedBeforeNewerPending)
+{
+  process_twist(1100);
+  process_pose(1000);
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].updater, "pose");
+  EXPECT_EQ(events[0].stamp, ms(1000));
+
+  // pending twist is released before next twist, stamps stay ordered
+  process_twist(1200);
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[1].updater, "twist");
+  EXPECT_EQ(events[1].stamp, ms(1100));
+
+  EXPECT_TRUE(interface->heartbeat_callback(ms(1300)));
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[2].stamp, ms(1200));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, updatersAreSwappedWhileUpdateIsInFlight)
+{
+  filter->is_deferred = true;
+  process_pose(1000);
+  process_twist(1000);
+  ASSERT_EQ(filter->deferred.size(), 1u);
+
+  // previous updaters are released by interface but kept alive by pending update
+  interface->load_updaters(
+    std::make_unique<PoseUpdater>("swapped_pose", events, filter),
+    std::make_unique<TwistUpdater>("swapped_twist", events, filter));
+  process_pose(1100);
+  process_twist(1100);
+  filter->run_deferred();
+
+  ASSERT_EQ(events.size(), 4u);
+  EXPECT_EQ(events[0].updater, "twist");
+  EXPECT_EQ(events[1].updater, "pose");
+  EXPECT_EQ(events[2].updater, "swapped_twist");
+  EXPECT_EQ(events[3].updater, "swapped_pose");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, messagesAreDroppedBeforeUpdatersAreLoaded)
+{
+  UpdaterInterface unloaded(node, "unloaded_pose", "unloaded_twist");
+  unloaded.process_pose_message(make_msg<UpdaterInterface::PoseMsg>(1000));
+  unloaded.process_twist_message(make_msg<UpdaterInterface::TwistMsg>(1000));
+  EXPECT_TRUE(unloaded.heartbeat_callback(ms(1100)));
+  EXPECT_TRUE(unloaded.get_report().info.empty());
+  EXPECT_EQ(filter->number_of_steps, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPoseTwistUpdaterInterface, pairedObservationsAreRecordedSeparately)
+{
+  std::remove("/tmp/pose_twist_observations.bin");
+  auto recorder = std::make_shared<romea::ros2::LocalisationObservationRecorder>(
+    "/tmp/pose_twist_observations.bin", 16, false);
+  interface->register_recorder(recorder, "pose", "twist");
+
+  process_pose(1000);
+  process_twist(1000);
+  process_twist(1100);
+  interface->flush();
+
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(recorder->get_number_of_records(), 3u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
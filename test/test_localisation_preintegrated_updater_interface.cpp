@@ -0,0 +1,221 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cstdio>
+#include <memory>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "test_utils.hpp"
+#include "romea_localisation_utils/filter/localisation_preintegrated_updater_interface.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface.hpp"
+
+template<>
+double fake_observation_value(const romea::core::ObservationLinearSpeed & observation)
+{
+  return observation.Y();
+}
+
+template<>
+double fake_observation_value(const romea::core::ObservationPose & observation)
+{
+  return observation.Y(romea::core::ObservationPose::POSITION_X);
+}
+
+namespace
+{
+
+using LinearSpeedMsg = romea_localisation_msgs::msg::ObservationTwist2DStamped;
+using LinearSpeedUpdater = FakeUpdater<romea::core::ObservationLinearSpeed>;
+using LinearSpeedInterface = romea::ros2::LocalisationPreintegratedUpdaterInterface<
+  FakeFilter, LinearSpeedUpdater, LinearSpeedMsg>;
+
+using PoseMsg = romea_localisation_msgs::msg::ObservationPose2DStamped;
+using PoseUpdater = FakeUpdater<romea::core::ObservationPose>;
+using PoseInterface = romea::ros2::LocalisationUpdaterInterface<FakeFilter, PoseUpdater, PoseMsg>;
+
+template<typename Msg>
+void set_stamp(const long & milliseconds, Msg & msg)
+{
+  msg.header.stamp.sec = static_cast<int32_t>(milliseconds / 1000);
+  msg.header.stamp.nanosec = static_cast<uint32_t>((milliseconds % 1000) * 1000000);
+}
+
+LinearSpeedMsg::ConstSharedPtr make_linear_speed_msg(const long & milliseconds, const double & v)
+{
+  auto msg = std::make_shared<LinearSpeedMsg>();
+  set_stamp(milliseconds, *msg);
+  msg->observation_twist.twist.linear_speeds.x = v;
+  msg->observation_twist.twist.covariance[0] = 0.01;
+  return msg;
+}
+
+PoseMsg::ConstSharedPtr make_pose_msg(const long & milliseconds, const double & x)
+{
+  auto msg = std::make_shared<PoseMsg>();
+  set_stamp(milliseconds, *msg);
+  msg->observation_pose.pose.position.x = x;
+  msg->observation_pose.pose.covariance[0] = 0.01;
+  msg->observation_pose.pose.covariance[4] = 0.01;
+  msg->observation_pose.pose.covariance[8] = 0.01;
+  return msg;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+class TestPreintegratedUpdaterInterface : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp::Node>("test_preintegrated_updater_interface");
+    filter = std::make_shared<FakeFilter>();
+    events.clear();
+
+    linear_speed_interface = romea::ros2::make_preintegrated_updater_interface<
+      LinearSpeedInterface>(
+      node, "linear_speed", 0.05, filter,
+      std::make_unique<LinearSpeedUpdater>("linear_speed", events));
+  }
+
+  std::shared_ptr<rclcpp::Node> node;
+  std::shared_ptr<FakeFilter> filter;
+  EventLog events;
+  std::unique_ptr<LinearSpeedInterface> linear_speed_interface;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPreintegratedUpdaterInterface, oneObservationPerIntervalStampedAtIntervalStart)
+{
+  linear_speed_interface->process_message(make_linear_speed_msg(1000, 1));
+  linear_speed_interface->process_message(make_linear_speed_msg(1020, 2));
+  linear_speed_interface->process_message(make_linear_speed_msg(1040, 3));
+  EXPECT_TRUE(events.empty());
+
+  linear_speed_interface->process_message(make_linear_speed_msg(1060, 4));
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].stamp, ms(1000));
+  EXPECT_NEAR(events[0].value, 2, 1e-12);
+
+  // last sample is held over next interval, flushed on heartbeat
+  linear_speed_interface->process_message(make_linear_speed_msg(1080, 6));
+  EXPECT_TRUE(linear_speed_interface->heartbeat_callback(ms(1090)));
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[1].stamp, ms(1060));
+  EXPECT_NEAR(events[1].value, 4, 1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPreintegratedUpdaterInterface, lateSampleIsProcessedAtItsStamp)
+{
+  linear_speed_interface->process_message(make_linear_speed_msg(1000, 1));
+  linear_speed_interface->process_message(make_linear_speed_msg(1020, 2));
+  linear_speed_interface->process_message(make_linear_speed_msg(1010, 5));
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].stamp, ms(1010));
+  EXPECT_DOUBLE_EQ(events[0].value, 5);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPreintegratedUpdaterInterface, pendingSamplesAreFlushedBeforeExteroceptiveUpdate)
+{
+  auto pose_interface = romea::ros2::make_updater_interface<PoseInterface>(
+    node, "pose", filter, std::make_unique<PoseUpdater>("pose", events));
+
+  LinearSpeedInterface * preintegrated = linear_speed_interface.get();
+  pose_interface->register_flush_callback([preintegrated]() {preintegrated->flush();});
+
+  linear_speed_interface->process_message(make_linear_speed_msg(1000, 1));
+  linear_speed_interface->process_message(make_linear_speed_msg(1020, 3));
+  pose_interface->process_message(make_pose_msg(1025, 10));
+
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].updater, "linear_speed");
+  EXPECT_EQ(events[0].stamp, ms(1000));
+  EXPECT_NEAR(events[0].value, 1, 1e-12);
+  EXPECT_EQ(events[1].updater, "pose");
+  EXPECT_EQ(events[1].stamp, ms(1025));
+  EXPECT_DOUBLE_EQ(events[1].value, 10);
+
+  // nothing left to flush
+  pose_interface->process_message(make_pose_msg(1030, 11));
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[2].updater, "pose");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPreintegratedUpdaterInterface, updaterIsSwappedWhileUpdateIsInFlight)
+{
+  filter->is_deferred = true;
+  linear_speed_interface->process_message(make_linear_speed_msg(1000, 1));
+  linear_speed_interface->flush();
+  ASSERT_EQ(filter->deferred.size(), 1u);
+
+  // previous updater is released by interface but kept alive by pending update
+  linear_speed_interface->load_updater(std::make_unique<LinearSpeedUpdater>("swapped", events));
+  linear_speed_interface->process_message(make_linear_speed_msg(1020, 2));
+  linear_speed_interface->flush();
+  filter->run_deferred();
+
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].updater, "linear_speed");
+  EXPECT_EQ(events[1].updater, "swapped");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPreintegratedUpdaterInterface, diagnosticsBeforeUpdaterIsLoaded)
+{
+  LinearSpeedInterface interface(node, "unloaded_linear_speed", 0.05);
+  EXPECT_TRUE(interface.heartbeat_callback(ms(1000)));
+  EXPECT_TRUE(interface.get_report().info.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPreintegratedUpdaterInterface, processedObservationsAreRecorded)
+{
+  std::remove("/tmp/preintegrated_observations.bin");
+  auto recorder = std::make_shared<romea::ros2::LocalisationObservationRecorder>(
+    "/tmp/preintegrated_observations.bin", 16, false);
+  linear_speed_interface->register_recorder(recorder, "linear_speed");
+
+  // one preintegrated observation and one late sample
+  linear_speed_interface->process_message(make_linear_speed_msg(1000, 1));
+  linear_speed_interface->process_message(make_linear_speed_msg(1020, 2));
+  linear_speed_interface->process_message(make_linear_speed_msg(1010, 5));
+  linear_speed_interface->flush();
+
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(recorder->get_number_of_records(), 2u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
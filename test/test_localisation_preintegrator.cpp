@@ -0,0 +1,143 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// gtest
+#include "gtest/gtest.h"
+
+// eigen
+#include "Eigen/Core"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_preintegrator.hpp"
+
+namespace
+{
+
+struct ScalarObservation
+{
+  double & Y() {return y;}
+  const double & Y() const {return y;}
+  double & R() {return r;}
+  const double & R() const {return r;}
+  double y = 0;
+  double r = 0;
+};
+
+struct VectorObservation
+{
+  Eigen::Vector3d & Y() {return y;}
+  const Eigen::Vector3d & Y() const {return y;}
+  Eigen::Matrix3d & R() {return r;}
+  const Eigen::Matrix3d & R() const {return r;}
+  Eigen::Vector3d y = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d r = Eigen::Matrix3d::Zero();
+  Eigen::Vector3d levelArm = Eigen::Vector3d::Zero();
+};
+
+ScalarObservation make_scalar_observation(const double & y, const double & r)
+{
+  ScalarObservation observation;
+  observation.y = y;
+  observation.r = r;
+  return observation;
+}
+
+romea::core::Duration ms(const long & milliseconds)
+{
+  return std::chrono::milliseconds(milliseconds);
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestPreintegrator, firstSampleIsForwarded)
+{
+  romea::ros2::LocalisationPreintegrator<ScalarObservation> preintegrator;
+  EXPECT_TRUE(preintegrator.empty());
+  EXPECT_TRUE(preintegrator.add(ms(1000), make_scalar_observation(2, 0.1)));
+  EXPECT_EQ(preintegrator.get_time_span(), ms(0));
+
+  auto observation = preintegrator.integrate();
+  EXPECT_DOUBLE_EQ(observation.Y(), 2);
+  EXPECT_DOUBLE_EQ(observation.R(), 0.1);
+  EXPECT_TRUE(preintegrator.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPreintegrator, timeWeightedMean)
+{
+  romea::ros2::LocalisationPreintegrator<ScalarObservation> preintegrator;
+  preintegrator.add(ms(0), make_scalar_observation(1, 0.1));
+  preintegrator.integrate();
+
+  // 1 is held during 30 ms, 4 during 10 ms
+  preintegrator.add(ms(30), make_scalar_observation(4, 0.1));
+  preintegrator.add(ms(40), make_scalar_observation(10, 0.1));
+  EXPECT_EQ(preintegrator.get_number_of_samples(), 2u);
+  EXPECT_EQ(preintegrator.get_time_span(), ms(40));
+  EXPECT_EQ(preintegrator.get_stamp(), ms(0));
+
+  auto observation = preintegrator.integrate();
+  EXPECT_NEAR(observation.Y(), (1 * 0.03 + 4 * 0.01) / 0.04, 1e-12);
+  EXPECT_NEAR(observation.R(), 0.1 * (0.03 * 0.03 + 0.01 * 0.01) / (0.04 * 0.04), 1e-12);
+
+  // last sample is held over next interval
+  preintegrator.add(ms(60), make_scalar_observation(0, 0.1));
+  EXPECT_EQ(preintegrator.get_stamp(), ms(40));
+  observation = preintegrator.integrate();
+  EXPECT_NEAR(observation.Y(), 10, 1e-12);
+  EXPECT_NEAR(observation.R(), 0.1, 1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPreintegrator, constantSamplesReduceVariance)
+{
+  romea::ros2::LocalisationPreintegrator<VectorObservation> preintegrator;
+
+  VectorObservation sample;
+  sample.y = Eigen::Vector3d(1, 0, 0.2);
+  sample.r = Eigen::Matrix3d::Identity() * 0.04;
+  sample.levelArm = Eigen::Vector3d(0.5, 0, 1);
+
+  preintegrator.add(ms(0), sample);
+  preintegrator.integrate();
+  for (long n = 1; n <= 10; ++n) {
+    preintegrator.add(ms(10 * n), sample);
+  }
+
+  auto observation = preintegrator.integrate();
+  EXPECT_TRUE(observation.Y().isApprox(sample.y));
+  EXPECT_TRUE(observation.R().isApprox(sample.r / 10));
+  EXPECT_TRUE(observation.levelArm.isApprox(sample.levelArm));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestPreintegrator, lateSampleIsRejected)
+{
+  romea::ros2::LocalisationPreintegrator<ScalarObservation> preintegrator;
+  EXPECT_TRUE(preintegrator.add(ms(100), make_scalar_observation(1, 0.1)));
+  EXPECT_FALSE(preintegrator.add(ms(50), make_scalar_observation(2, 0.1)));
+  EXPECT_EQ(preintegrator.get_number_of_samples(), 1u);
+
+  preintegrator.reset();
+  EXPECT_TRUE(preintegrator.empty());
+  EXPECT_TRUE(preintegrator.add(ms(50), make_scalar_observation(2, 0.1)));
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
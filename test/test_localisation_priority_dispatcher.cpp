@@ -0,0 +1,157 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_priority_dispatcher.hpp"
+
+
+//-----------------------------------------------------------------------------
+class TestPriorityDispatcher : public ::testing::Test
+{
+public:
+  TestPriorityDispatcher()
+  : dispatcher(4, std::chrono::milliseconds(100)),
+    processed(),
+    twist_id(dispatcher.register_updater("twist_updater", 0)),
+    pose_id(dispatcher.register_updater("pose_updater", 10))
+  {
+  }
+
+  void dispatch(const size_t & updater_id, const std::string & name)
+  {
+    dispatcher.dispatch(
+      updater_id, romea::core::Duration::zero(), [this, name]() {processed.push_back(name);});
+  }
+
+  romea::ros2::LocalisationPriorityDispatcher dispatcher;
+  std::vector<std::string> processed;
+  size_t twist_id;
+  size_t pose_id;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPriorityDispatcher, highestPriorityFirst)
+{
+  dispatch(twist_id, "twist1");
+  dispatch(twist_id, "twist2");
+  dispatch(pose_id, "pose1");
+  EXPECT_EQ(dispatcher.get_queue_size(), 3u);
+
+  while (dispatcher.process_next()) {
+  }
+
+  std::vector<std::string> expected = {"pose1", "twist1", "twist2"};
+  EXPECT_EQ(processed, expected);
+  EXPECT_EQ(dispatcher.get_queue_size(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPriorityDispatcher, lowPriorityIsShedWhenQueueIsFull)
+{
+  for (int n = 0; n < 4; ++n) {
+    dispatch(twist_id, "twist" + std::to_string(n));
+  }
+
+  // oldest low priority job makes room for high priority one
+  dispatch(pose_id, "pose");
+  // queue is full, oldest job of same priority makes room for newer one
+  dispatch(twist_id, "twist4");
+
+  EXPECT_EQ(dispatcher.get_number_of_shed_jobs(twist_id), 2u);
+  EXPECT_EQ(dispatcher.get_number_of_shed_jobs(pose_id), 0u);
+
+  while (dispatcher.process_next()) {
+  }
+
+  std::vector<std::string> expected = {"pose", "twist2", "twist3", "twist4"};
+  EXPECT_EQ(processed, expected);
+
+  auto report = dispatcher.get_report();
+  EXPECT_EQ(report.info["twist_updater_shed"], "2");
+  EXPECT_EQ(report.info["pose_updater_processed"], "1");
+  EXPECT_EQ(report.diagnostics.size(), 1u);
+
+  romea::core::DiagnosticReport twist_report;
+  dispatcher.append_to_report(twist_id, twist_report);
+  EXPECT_EQ(twist_report.info["dispatcher_shed"], "2");
+  EXPECT_EQ(twist_report.info["dispatcher_processed"], "3");
+  EXPECT_EQ(twist_report.diagnostics.size(), 1u);
+
+  romea::core::DiagnosticReport pose_report;
+  dispatcher.append_to_report(pose_id, pose_report);
+  EXPECT_EQ(pose_report.info["dispatcher_shed"], "0");
+  EXPECT_TRUE(pose_report.diagnostics.empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPriorityDispatcher, delayedJobsAreCounted)
+{
+  dispatch(twist_id, "twist");
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  dispatch(pose_id, "pose");
+
+  while (dispatcher.process_next()) {
+  }
+
+  EXPECT_EQ(dispatcher.get_number_of_delayed_jobs(twist_id), 1u);
+  EXPECT_EQ(dispatcher.get_number_of_delayed_jobs(pose_id), 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPriorityDispatcher, jobsAreRunByDispatcherThread)
+{
+  std::atomic<size_t> counter(0);
+  dispatcher.start();
+  for (int n = 0; n < 100; ++n) {
+    dispatcher.dispatch(twist_id, romea::core::Duration::zero(), [&counter]() {++counter;});
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (counter.load() + dispatcher.get_number_of_shed_jobs(twist_id) < 100 &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  dispatcher.stop();
+
+  EXPECT_EQ(counter.load() + dispatcher.get_number_of_shed_jobs(twist_id), 100u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestPriorityDispatcher, jobsCannotBeRunOutsideOfStartedDispatcher)
+{
+  dispatcher.start();
+  EXPECT_THROW(dispatcher.process_next(), std::runtime_error);
+  dispatcher.stop();
+  EXPECT_FALSE(dispatcher.process_next());
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <cmath>
+#include <random>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_range_likelihood.hpp"
+
+
+//-----------------------------------------------------------------------------
+class TestRangeLikelihood : public ::testing::Test
+{
+public:
+  TestRangeLikelihood()
+  : x(),
+    y(),
+    yaw(),
+    observation(),
+    likelihood()
+  {
+  }
+
+  void SetUp()override
+  {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> position(-10, 10);
+    std::uniform_real_distribution<double> orientation(-M_PI, M_PI);
+    for (size_t n = 0; n < 1003; ++n) {
+      x.push_back(position(generator));
+      y.push_back(position(generator));
+      yaw.push_back(orientation(generator));
+    }
+
+    observation.Y() = 8;
+    observation.R() = 0.04;
+    observation.initiatorPosition.x() = 0.5;
+    observation.initiatorPosition.y() = -0.2;
+    observation.initiatorPosition.z() = 1.5;
+    observation.responderPosition.x() = 3;
+    observation.responderPosition.y() = 4;
+    observation.responderPosition.z() = 2.5;
+    likelihood.set_particles(x.data(), y.data(), yaw.data(), x.size());
+  }
+
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> yaw;
+  romea::core::ObservationRange observation;
+  romea::ros2::LocalisationRangeLikelihood likelihood;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRangeLikelihood, singleParticle)
+{
+  std::vector<double> x = {-0.5};
+  std::vector<double> y = {0.2};
+  std::vector<double> yaw = {0};
+  observation.Y() = std::sqrt(3 * 3 + 4 * 4 + 1);
+  likelihood.set_particles(x.data(), y.data(), yaw.data(), 1);
+
+  double value;
+  likelihood.evaluate(observation, &value);
+  EXPECT_DOUBLE_EQ(value, 1.0);
+
+  observation.Y() += 0.2;
+  likelihood.evaluate(observation, &value);
+  EXPECT_NEAR(value, std::exp(-0.5), 1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRangeLikelihood, simdMatchesScalar)
+{
+  std::vector<double> simd_likelihoods(x.size());
+  std::vector<double> scalar_likelihoods(x.size());
+  likelihood.evaluate(observation, simd_likelihoods.data());
+  likelihood.evaluate_scalar(observation, scalar_likelihoods.data());
+  for (size_t n = 0; n < x.size(); ++n) {
+    EXPECT_NEAR(simd_likelihoods[n], scalar_likelihoods[n], 1e-12);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRangeLikelihood, farParticlesHaveNullLikelihood)
+{
+  std::vector<double> likelihoods(x.size());
+  observation.Y() = 1000;
+  likelihood.evaluate(observation, likelihoods.data());
+  for (const auto & value : likelihoods) {
+    EXPECT_EQ(value, 0.0);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRangeLikelihood, weightByBatches)
+{
+  std::vector<double> likelihoods(x.size());
+  std::vector<double> weights(x.size(), 0.5);
+  likelihood.evaluate_scalar(observation, likelihoods.data());
+  likelihood.weight(observation, weights.data(), 0, 500);
+  likelihood.weight(observation, weights.data(), 500, x.size());
+  for (size_t n = 0; n < x.size(); ++n) {
+    EXPECT_NEAR(weights[n], 0.5 * likelihoods[n], 1e-12);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestRangeLikelihood, throwWithNullVariance)
+{
+  std::vector<double> likelihoods(x.size());
+  observation.R() = 0;
+  EXPECT_THROW(likelihood.evaluate(observation, likelihoods.data()), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_sequencer.hpp"
+
+using std::chrono::milliseconds;
+
+namespace
+{
+
+// processing order of given inputs, each updater dispatching from its own thread
+std::vector<std::string> replay(const std::vector<std::vector<long>> & stamps)
+{
+  romea::ros2::LocalisationSequencer sequencer(milliseconds(0));
+  std::vector<size_t> ids;
+  for (size_t n = 0; n < stamps.size(); ++n) {
+    ids.push_back(sequencer.register_updater("updater" + std::to_string(n), 0));
+  }
+
+  std::vector<std::string> processed;
+  std::vector<std::thread> threads;
+  for (size_t n = 0; n < stamps.size(); ++n) {
+    threads.emplace_back(
+      [&, n]() {
+        for (long stamp : stamps[n]) {
+          sequencer.dispatch(
+            ids[n], milliseconds(stamp), [&processed, n, stamp]() {
+              processed.push_back(std::to_string(stamp) + "/" + std::to_string(n));
+            });
+        }
+      });
+  }
+
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  sequencer.flush();
+  return processed;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestSequencer, jobsAreReleasedByWatermark)
+{
+  romea::ros2::LocalisationSequencer sequencer(milliseconds(0));
+  size_t twist_id = sequencer.register_updater("twist_updater", 0);
+  size_t pose_id = sequencer.register_updater("pose_updater", 0);
+
+  std::vector<long> processed;
+  auto dispatch = [&](size_t id, long stamp) {
+      sequencer.dispatch(
+        id, milliseconds(stamp), [&processed, stamp]() {processed.push_back(stamp);});
+    };
+
+  dispatch(twist_id, 10);
+  dispatch(twist_id, 20);
+  dispatch(twist_id, 30);
+  // pose updater has not received anything yet
+  EXPECT_TRUE(processed.empty());
+  EXPECT_EQ(sequencer.get_number_of_pending_jobs(), 3u);
+
+  dispatch(pose_id, 15);
+  EXPECT_EQ(processed, (std::vector<long>{10, 15}));
+
+  dispatch(pose_id, 40);
+  EXPECT_EQ(processed, (std::vector<long>{10, 15, 20, 30}));
+
+  sequencer.flush();
+  EXPECT_EQ(processed, (std::vector<long>{10, 15, 20, 30, 40}));
+  EXPECT_EQ(sequencer.get_number_of_dispatched_jobs(), 5u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSequencer, sameStampIsOrderedByUpdaterId)
+{
+  romea::ros2::LocalisationSequencer sequencer(milliseconds(0));
+  size_t twist_id = sequencer.register_updater("twist_updater", 0);
+  size_t pose_id = sequencer.register_updater("pose_updater", 0);
+
+  std::vector<std::string> processed;
+  sequencer.dispatch(pose_id, milliseconds(10), [&]() {processed.push_back("pose");});
+  sequencer.dispatch(twist_id, milliseconds(10), [&]() {processed.push_back("twist");});
+  sequencer.flush();
+
+  EXPECT_EQ(processed, (std::vector<std::string>{"twist", "pose"}));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSequencer, reorderWindowReleasesSilentUpdater)
+{
+  romea::ros2::LocalisationSequencer sequencer(milliseconds(50));
+  size_t twist_id = sequencer.register_updater("twist_updater", 0);
+  size_t pose_id = sequencer.register_updater("pose_updater", 0);
+
+  std::vector<long> processed;
+  for (long stamp = 10; stamp <= 100; stamp += 10) {
+    sequencer.dispatch(
+      twist_id, milliseconds(stamp), [&processed, stamp]() {processed.push_back(stamp);});
+  }
+  EXPECT_EQ(processed, (std::vector<long>{10, 20, 30, 40, 50}));
+
+  // late observation is processed immediately and reported
+  sequencer.dispatch(pose_id, milliseconds(20), [&processed]() {processed.push_back(-20);});
+  EXPECT_EQ(processed.back(), -20);
+  EXPECT_EQ(sequencer.get_number_of_late_jobs(), 1u);
+  EXPECT_EQ(sequencer.get_report().diagnostics.size(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestSequencer, orderDoesNotDependOnThreadScheduling)
+{
+  std::vector<std::vector<long>> stamps = {
+    {0, 10, 20, 30, 40, 50, 60, 70, 80, 90},
+    {5, 25, 45, 65, 85},
+    {10, 20, 30, 40, 50}};
+
+  auto reference = replay(stamps);
+  ASSERT_EQ(reference.size(), 20u);
+  for (int n = 0; n < 20; ++n) {
+    EXPECT_EQ(replay(stamps), reference);
+  }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
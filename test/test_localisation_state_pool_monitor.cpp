@@ -0,0 +1,92 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_state_pool_monitor.hpp"
+
+namespace
+{
+romea::core::Duration stamp(const double & seconds)
+{
+  return romea::core::durationFromSecond(seconds);
+}
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStatePoolMonitor, inOrderObservations)
+{
+  romea::ros2::LocalisationStatePoolMonitor monitor(5);
+  for (size_t n = 0; n < 10; ++n) {
+    EXPECT_TRUE(monitor.check(stamp(n * 0.1)));
+  }
+  EXPECT_EQ(monitor.get_number_of_rollbacks(), 0u);
+  EXPECT_EQ(monitor.get_time_span(), stamp(0.4));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStatePoolMonitor, rollbackInsidePool)
+{
+  romea::ros2::LocalisationStatePoolMonitor monitor(5);
+  for (size_t n = 0; n < 10; ++n) {
+    monitor.check(stamp(n * 0.1));
+  }
+  EXPECT_TRUE(monitor.check(stamp(0.75)));
+  EXPECT_EQ(monitor.get_number_of_rollbacks(), 1u);
+  EXPECT_EQ(monitor.get_number_of_out_of_pool_rollbacks(), 0u);
+  EXPECT_EQ(monitor.get_maximal_rollback_depth(), stamp(0.15));
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStatePoolMonitor, rollbackOutsidePool)
+{
+  romea::ros2::LocalisationStatePoolMonitor monitor(5);
+  for (size_t n = 0; n < 10; ++n) {
+    monitor.check(stamp(n * 0.1));
+  }
+  EXPECT_FALSE(monitor.check(stamp(0.45)));
+  EXPECT_EQ(monitor.get_number_of_out_of_pool_rollbacks(), 1u);
+  EXPECT_EQ(monitor.get_report().diagnostics.size(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStatePoolMonitor, outOfOrderObservations)
+{
+  romea::ros2::LocalisationStatePoolMonitor monitor(3);
+  EXPECT_TRUE(monitor.check(stamp(1.0)));
+  EXPECT_TRUE(monitor.check(stamp(0.5)));
+  EXPECT_TRUE(monitor.check(stamp(2.0)));
+  EXPECT_EQ(monitor.get_time_span(), stamp(1.5));
+
+  // oldest state is the one stamped 0.5 even though it was not the first inserted
+  EXPECT_TRUE(monitor.check(stamp(0.7)));
+  EXPECT_EQ(monitor.get_time_span(), stamp(1.3));
+  EXPECT_FALSE(monitor.check(stamp(0.6)));
+  EXPECT_EQ(monitor.get_number_of_out_of_pool_rollbacks(), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStatePoolMonitor, throwWithEmptyPool)
+{
+  EXPECT_THROW(romea::ros2::LocalisationStatePoolMonitor(0), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_status_aggregator.hpp"
+
+using romea::core::LocalisationFSMState;
+
+//-----------------------------------------------------------------------------
+TEST(TestStatusAggregator, singleSourceTransitions)
+{
+  romea::ros2::LocalisationStatusAggregator aggregator;
+  size_t id = aggregator.register_source("filter");
+  EXPECT_EQ(aggregator.get_status(), LocalisationFSMState::INIT);
+
+  EXPECT_FALSE(aggregator.update(id, LocalisationFSMState::INIT));
+  EXPECT_TRUE(aggregator.update(id, LocalisationFSMState::RUNNING));
+  EXPECT_FALSE(aggregator.update(id, LocalisationFSMState::RUNNING));
+  EXPECT_FALSE(aggregator.update(id, LocalisationFSMState::RUNNING));
+  EXPECT_TRUE(aggregator.update(id, LocalisationFSMState::ABORTED));
+  EXPECT_EQ(aggregator.get_status(), LocalisationFSMState::ABORTED);
+  EXPECT_EQ(aggregator.get_number_of_transitions(), 2u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStatusAggregator, leastHealthySourceWins)
+{
+  romea::ros2::LocalisationStatusAggregator aggregator;
+  size_t robot1 = aggregator.register_source("robot1");
+  size_t robot2 = aggregator.register_source("robot2");
+  EXPECT_EQ(aggregator.get_number_of_sources(), 2u);
+  EXPECT_EQ(aggregator.get_source_name(robot2), "robot2");
+
+  // robot2 is still initialising
+  EXPECT_FALSE(aggregator.update(robot1, LocalisationFSMState::RUNNING));
+  EXPECT_EQ(aggregator.get_status(), LocalisationFSMState::INIT);
+
+  EXPECT_TRUE(aggregator.update(robot2, LocalisationFSMState::RUNNING));
+  EXPECT_EQ(aggregator.get_status(), LocalisationFSMState::RUNNING);
+
+  EXPECT_TRUE(aggregator.update(robot1, LocalisationFSMState::ABORTED));
+  EXPECT_FALSE(aggregator.update(robot2, LocalisationFSMState::INIT));
+  EXPECT_EQ(aggregator.get_status(), LocalisationFSMState::ABORTED);
+
+  EXPECT_TRUE(aggregator.update(robot1, LocalisationFSMState::RUNNING));
+  EXPECT_EQ(aggregator.get_status(), LocalisationFSMState::INIT);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,110 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_thread_pool.hpp"
+
+namespace
+{
+
+void check_parallel_for(romea::ros2::LocalisationThreadPool & pool, const size_t & size)
+{
+  std::vector<int> counts(size, 0);
+  pool.parallel_for(
+    size, [&](size_t begin, size_t end) {
+      for (size_t n = begin; n < end; ++n) {
+        counts[n]++;
+      }
+    }, 16);
+
+  for (const auto & count : counts) {
+    ASSERT_EQ(count, 1);
+  }
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestThreadPool, singleThread)
+{
+  romea::ros2::LocalisationThreadPool pool(1);
+  EXPECT_EQ(pool.get_number_of_threads(), 1u);
+  check_parallel_for(pool, 5000);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestThreadPool, everyIndexIsProcessedOnce)
+{
+  romea::ros2::LocalisationThreadPool pool(4);
+  EXPECT_EQ(pool.get_number_of_threads(), 4u);
+  for (size_t size : {0u, 1u, 15u, 16u, 17u, 1000u, 5003u}) {
+    check_parallel_for(pool, size);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestThreadPool, successiveJobs)
+{
+  romea::ros2::LocalisationThreadPool pool(3);
+  for (size_t n = 0; n < 200; ++n) {
+    check_parallel_for(pool, 1000 + n);
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestThreadPool, taskExceptionIsRethrown)
+{
+  romea::ros2::LocalisationThreadPool pool(4);
+  for (size_t failing_index : {0u, 500u, 999u}) {
+    EXPECT_THROW(
+      pool.parallel_for(
+        1000, [&](size_t begin, size_t end) {
+          if (begin <= failing_index && failing_index < end) {
+            throw std::runtime_error("task failure");
+          }
+        }, 16),
+      std::runtime_error);
+  }
+
+  EXPECT_THROW(
+    pool.parallel_for(
+      1000, [](size_t, size_t) {
+        throw std::runtime_error("task failure");
+      }, 16),
+    std::runtime_error);
+
+  // pool is still usable after a failure
+  check_parallel_for(pool, 1000);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestThreadPool, throwWithoutThread)
+{
+  EXPECT_THROW(romea::ros2::LocalisationThreadPool(0), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
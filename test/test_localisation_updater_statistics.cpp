@@ -0,0 +1,138 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/localisation_updater_statistics.hpp"
+
+using std::chrono::milliseconds;
+
+//-----------------------------------------------------------------------------
+TEST(TestUpdaterStatistics, regularStream)
+{
+  romea::ros2::LocalisationUpdaterStatistics statistics;
+  for (long n = 0; n < 200; ++n) {
+    statistics.update(milliseconds(10 * n), milliseconds(10 * n + 5));
+  }
+
+  auto snapshot = statistics.get_snapshot();
+  EXPECT_EQ(snapshot.number_of_messages, 200u);
+  EXPECT_NEAR(snapshot.rate, 100, 1e-6);
+  EXPECT_NEAR(snapshot.jitter, 0, 1e-9);
+  EXPECT_NEAR(snapshot.mean_delay, 0.005, 1e-9);
+  EXPECT_NEAR(snapshot.maximal_delay, 0.005, 1e-9);
+  EXPECT_EQ(snapshot.number_of_bursts, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestUpdaterStatistics, jitteryStream)
+{
+  romea::ros2::LocalisationUpdaterStatistics statistics;
+  long arrival = 0;
+  for (long n = 0; n < 500; ++n) {
+    arrival += n % 2 ? 8 : 12;
+    statistics.update(milliseconds(arrival), milliseconds(arrival));
+  }
+
+  auto snapshot = statistics.get_snapshot();
+  EXPECT_NEAR(snapshot.rate, 100, 2);
+  EXPECT_NEAR(snapshot.jitter, 0.002, 0.0005);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestUpdaterStatistics, burstsAreDetected)
+{
+  romea::ros2::LocalisationUpdaterStatistics statistics;
+  long arrival = 0;
+  for (long n = 0; n < 100; ++n) {
+    arrival += 10;
+    statistics.update(milliseconds(arrival), milliseconds(arrival));
+  }
+
+  // two bursts of 4 and 3 messages after a stall
+  for (int burst_size : {4, 3}) {
+    arrival += 40;
+    for (int n = 0; n < burst_size; ++n) {
+      statistics.update(milliseconds(arrival), milliseconds(arrival));
+    }
+    for (int n = 0; n < 20; ++n) {
+      arrival += 10;
+      statistics.update(milliseconds(arrival), milliseconds(arrival));
+    }
+  }
+
+  auto snapshot = statistics.get_snapshot();
+  EXPECT_EQ(snapshot.number_of_bursts, 2u);
+  EXPECT_EQ(snapshot.maximal_burst_size, 4u);
+
+  romea::core::DiagnosticReport report;
+  statistics.append_to_report(report);
+  EXPECT_EQ(report.info["bursts"], "2");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestUpdaterStatistics, outOfOrderMessagesAreCounted)
+{
+  romea::ros2::LocalisationUpdaterStatistics statistics;
+  std::chrono::nanoseconds base(1700000000123456789);
+  statistics.update(base, base);
+  statistics.update(base, base + milliseconds(1));
+  statistics.update(base - std::chrono::nanoseconds(1), base + milliseconds(2));
+  statistics.update(base + milliseconds(10), base + milliseconds(10));
+  statistics.update(base + milliseconds(5), base + milliseconds(11));
+
+  EXPECT_EQ(statistics.get_snapshot().number_of_out_of_order_messages, 2u);
+
+  romea::core::DiagnosticReport report;
+  statistics.append_to_report(report);
+  EXPECT_EQ(report.info["out_of_order_messages"], "2");
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestUpdaterStatistics, concurrentReadsAreConsistent)
+{
+  romea::ros2::LocalisationUpdaterStatistics statistics;
+  std::atomic<bool> stop(false);
+
+  std::thread reader([&]() {
+      uint64_t last_number_of_messages = 0;
+      while (!stop) {
+        auto snapshot = statistics.get_snapshot();
+        EXPECT_GE(snapshot.number_of_messages, last_number_of_messages);
+        last_number_of_messages = snapshot.number_of_messages;
+      }
+    });
+
+  for (long n = 0; n < 100000; ++n) {
+    statistics.update(milliseconds(n), milliseconds(n + 1));
+  }
+  stop = true;
+  reader.join();
+
+  EXPECT_EQ(statistics.get_snapshot().number_of_messages, 100000u);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "test_utils.hpp"
+#include "romea_localisation_utils/filter/localisation_updater_interface.hpp"
+#include "romea_localisation_utils/filter/localisation_waitset_runtime.hpp"
+
+namespace
+{
+
+using PoseMsg = romea_localisation_msgs::msg::ObservationPose2DStamped;
+using PoseUpdater = FakeUpdater<romea::core::ObservationPose>;
+using PoseInterface = romea::ros2::LocalisationUpdaterInterface<FakeFilter, PoseUpdater, PoseMsg>;
+
+using TwistMsg = romea_localisation_msgs::msg::ObservationTwist2DStamped;
+using TwistUpdater = FakeUpdater<romea::core::ObservationTwist>;
+using TwistInterface =
+  romea::ros2::LocalisationUpdaterInterface<FakeFilter, TwistUpdater, TwistMsg>;
+
+template<typename Msg>
+Msg make_msg(const long & milliseconds)
+{
+  Msg msg;
+  msg.header.stamp.sec = static_cast<int32_t>(milliseconds / 1000);
+  msg.header.stamp.nanosec = static_cast<uint32_t>((milliseconds % 1000) * 1000000);
+  return msg;
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+class TestWaitSetRuntime : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp::Node>("test_waitset_runtime");
+    filter = std::make_shared<FakeFilter>();
+    runtime = std::make_unique<romea::ros2::LocalisationWaitSetRuntime>(
+      node, -1, std::chrono::milliseconds(100));
+
+    pose_interface = romea::ros2::make_updater_interface<PoseInterface>(
+      node, "pose", filter, std::make_unique<PoseUpdater>("pose", events),
+      runtime->get_callback_group());
+    twist_interface = romea::ros2::make_updater_interface<TwistInterface>(
+      node, "twist", filter, std::make_unique<TwistUpdater>("twist", events),
+      runtime->get_callback_group());
+
+    runtime->add_updater_interface(*pose_interface);
+    runtime->add_updater_interface(*twist_interface);
+
+    pose_pub = node->create_publisher<PoseMsg>("pose", romea::ros2::best_effort(1));
+    twist_pub = node->create_publisher<TwistMsg>("twist", romea::ros2::best_effort(1));
+
+    // best effort messages published before discovery would be lost
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((pose_pub->get_subscription_count() == 0 || twist_pub->get_subscription_count() == 0) &&
+      std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  void TearDown() override
+  {
+    runtime.reset();
+  }
+
+  bool wait_for_events(const size_t & number_of_events)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (events.get().size() < number_of_events) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+  }
+
+  std::shared_ptr<rclcpp::Node> node;
+  std::shared_ptr<FakeFilter> filter;
+  EventLog events;
+  std::unique_ptr<romea::ros2::LocalisationWaitSetRuntime> runtime;
+  std::unique_ptr<PoseInterface> pose_interface;
+  std::unique_ptr<TwistInterface> twist_interface;
+  std::shared_ptr<rclcpp::Publisher<PoseMsg>> pose_pub;
+  std::shared_ptr<rclcpp::Publisher<TwistMsg>> twist_pub;
+};
+
+//-----------------------------------------------------------------------------
+TEST_F(TestWaitSetRuntime, readyMessagesAreProcessedInStampOrder)
+{
+  pose_pub->publish(make_msg<PoseMsg>(1200));
+  twist_pub->publish(make_msg<TwistMsg>(1100));
+
+  // both messages are ready before wait, they are taken together
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  runtime->spin_some();
+
+  auto processed = events.get();
+  ASSERT_EQ(processed.size(), 2u);
+  EXPECT_EQ(processed[0].updater, "twist");
+  EXPECT_EQ(processed[0].stamp, ms(1100));
+  EXPECT_EQ(processed[1].updater, "pose");
+  EXPECT_EQ(processed[1].stamp, ms(1200));
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestWaitSetRuntime, stopJoinsRuntimeThread)
+{
+  runtime->start();
+  pose_pub->publish(make_msg<PoseMsg>(1000));
+  EXPECT_TRUE(wait_for_events(1));
+
+  runtime->stop();
+  twist_pub->publish(make_msg<TwistMsg>(1100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  EXPECT_EQ(events.get().size(), 1u);
+
+  // pending message is taken once restarted
+  runtime->start();
+  EXPECT_TRUE(wait_for_events(2));
+  runtime->stop();
+  EXPECT_EQ(events.get().back().updater, "twist");
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestWaitSetRuntime, subscriptionOutOfRuntimeCallbackGroupIsRejected)
+{
+  auto interface = romea::ros2::make_updater_interface<PoseInterface>(
+    node, "other_pose", filter, std::make_unique<PoseUpdater>("other_pose", events));
+  EXPECT_THROW(runtime->add_updater_interface(*interface), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestWaitSetRuntime, subscriptionCannotBeAddedToRunningRuntime)
+{
+  auto interface = romea::ros2::make_updater_interface<PoseInterface>(
+    node, "other_pose", filter, std::make_unique<PoseUpdater>("other_pose", events),
+    runtime->get_callback_group());
+
+  runtime->start();
+  EXPECT_THROW(runtime->add_updater_interface(*interface), std::runtime_error);
+  runtime->stop();
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
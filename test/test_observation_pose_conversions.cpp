@@ -107,6 +107,41 @@ TEST_F(TestObsPoseConversion, fromRosMsgtoObs)
   isSame(romea_obs_pose_bis.R(), romea_obs_pose.R());
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestObsPoseConversion, fromRosMsgtoObsWithLeverArmRegistry)
+{
+  romea::ros2::LeverArmRegistry lever_arms;
+  romea::core::ObservationPose romea_obs_pose_bis;
+
+  romea::ros2::extract_obs(romea_obs_pose_msg, lever_arms, romea_obs_pose_bis);
+  EXPECT_DOUBLE_EQ(romea_obs_pose_bis.levelArm.x(), romea_obs_pose.levelArm.x());
+
+  lever_arms.set(frame_id, Eigen::Vector3d(7, 8, 9));
+  romea::ros2::extract_obs(romea_obs_pose_msg, lever_arms, romea_obs_pose_bis);
+  EXPECT_DOUBLE_EQ(
+    romea_obs_pose_bis.Y(romea::core::ObservationPose::POSITION_X),
+    romea_obs_pose.Y(romea::core::ObservationPose::POSITION_X));
+  EXPECT_DOUBLE_EQ(romea_obs_pose_bis.levelArm.x(), 7);
+  EXPECT_DOUBLE_EQ(romea_obs_pose_bis.levelArm.y(), 8);
+  EXPECT_DOUBLE_EQ(romea_obs_pose_bis.levelArm.z(), 9);
+  isSame(romea_obs_pose_bis.R(), romea_obs_pose.R());
+}
+
+//-----------------------------------------------------------------------------
+TEST_F(TestObsPoseConversion, fromRomeato_ros_msgKeepsFrameId)
+{
+  romea_obs_pose.Y(romea::core::ObservationPose::POSITION_X) = 10;
+  rclcpp::Time new_stamp(2000);
+  romea::ros2::to_ros_msg(new_stamp, romea_obs_pose, romea_obs_pose_msg);
+
+  EXPECT_EQ(
+    romea::ros2::extract_time(romea_obs_pose_msg).nanoseconds(),
+    new_stamp.nanoseconds());
+  EXPECT_STREQ(romea_obs_pose_msg.header.frame_id.c_str(), frame_id.c_str());
+  EXPECT_DOUBLE_EQ(romea_obs_pose_msg.observation_pose.pose.position.x, 10);
+  isSame(romea_obs_pose_msg.observation_pose.pose.covariance, romea_obs_pose.R());
+}
+
 
 //-----------------------------------------------------------------------------
 class TestPoseConversion : public ::testing::Test
@@ -108,6 +108,29 @@ TEST_F(TestObsRangeConversion, fromRosMsgtoObs)
     romea_obs_range.responderPosition.z());
 }
 
+//-----------------------------------------------------------------------------
+TEST_F(TestObsRangeConversion, fromRosMsgToObsWithAnchorTable)
+{
+  romea::ros2::RangeAnchorTable anchors;
+  anchors.add("bar", Eigen::Vector3d(10, 20, 30));
+  anchors.add(frame_id, Eigen::Vector3d(7, 8, 9));
+
+  romea::core::ObservationRange romea_obs_range_bis;
+  EXPECT_TRUE(romea::ros2::extract_obs(ros_obs_range_msg, anchors, romea_obs_range_bis));
+  EXPECT_DOUBLE_EQ(romea_obs_range_bis.Y(), romea_obs_range.Y());
+  EXPECT_DOUBLE_EQ(romea_obs_range_bis.R(), romea_obs_range.R());
+  EXPECT_DOUBLE_EQ(
+    romea_obs_range_bis.initiatorPosition.x(),
+    romea_obs_range.initiatorPosition.x());
+  EXPECT_DOUBLE_EQ(romea_obs_range_bis.responderPosition.x(), 7);
+  EXPECT_DOUBLE_EQ(romea_obs_range_bis.responderPosition.y(), 8);
+  EXPECT_DOUBLE_EQ(romea_obs_range_bis.responderPosition.z(), 9);
+
+  ros_obs_range_msg.header.frame_id = "unknown";
+  EXPECT_FALSE(romea::ros2::extract_obs(ros_obs_range_msg, anchors, romea_obs_range_bis));
+  EXPECT_DOUBLE_EQ(romea_obs_range_bis.responderPosition.x(), 7);
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char ** argv)
 {
@@ -0,0 +1,75 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <string>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "test_helper.h"
+#include "romea_localisation_utils/conversions/range_anchor_table.hpp"
+
+
+//-----------------------------------------------------------------------------
+TEST(TestRangeAnchorTable, addAndFind)
+{
+  romea::ros2::RangeAnchorTable anchors;
+  anchors.add("A1", Eigen::Vector3d(1, 2, 3));
+  anchors.add("A2", Eigen::Vector3d(4, 5, 6));
+  EXPECT_EQ(anchors.size(), 2u);
+
+  size_t index = anchors.find("A2");
+  ASSERT_NE(index, romea::ros2::RangeAnchorTable::NOT_FOUND);
+  EXPECT_DOUBLE_EQ(anchors.get_position(index).x(), 4);
+  EXPECT_EQ(anchors.find("A3"), romea::ros2::RangeAnchorTable::NOT_FOUND);
+  EXPECT_THROW(anchors.get_position("A3"), std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestRangeAnchorTable, addExistingAnchorUpdatesPosition)
+{
+  romea::ros2::RangeAnchorTable anchors;
+  anchors.add("A1", Eigen::Vector3d(1, 2, 3));
+  anchors.add("A1", Eigen::Vector3d(7, 8, 9));
+  EXPECT_EQ(anchors.size(), 1u);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A1").z(), 9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestRangeAnchorTable, loadFromFile)
+{
+  auto anchors = romea::ros2::RangeAnchorTable::load(
+    std::string(TEST_DIR) + "/test_range_anchors.txt");
+  EXPECT_EQ(anchors.size(), 3u);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A2").x(), 50.0);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A3").y(), 30.0);
+  EXPECT_DOUBLE_EQ(anchors.get_position("A3").z(), 3.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestRangeAnchorTable, loadFromUnknownFile)
+{
+  EXPECT_THROW(
+    romea::ros2::RangeAnchorTable::load(std::string(TEST_DIR) + "/unknown.txt"),
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,53 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/conversions/stamp_conversions.hpp"
+
+//-----------------------------------------------------------------------------
+TEST(TestStampConversion, toNanoseconds)
+{
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = 1700000000;
+  stamp.nanosec = 123456789;
+  EXPECT_EQ(romea::ros2::to_nanoseconds(stamp), 1700000000123456789);
+
+  stamp.sec = 2147483647;
+  stamp.nanosec = 999999999;
+  EXPECT_EQ(romea::ros2::to_nanoseconds(stamp), 2147483647999999999);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestStampConversion, consecutiveStampsAreOrdered)
+{
+  builtin_interfaces::msg::Time first;
+  first.sec = 1700000000;
+  first.nanosec = 123456789;
+
+  builtin_interfaces::msg::Time second = first;
+  second.nanosec += 1;
+
+  EXPECT_LT(romea::ros2::to_nanoseconds(first), romea::ros2::to_nanoseconds(second));
+  EXPECT_EQ(romea::ros2::to_nanoseconds(second) - romea::ros2::to_nanoseconds(first), 1);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
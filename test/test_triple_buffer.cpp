@@ -0,0 +1,111 @@
+// Copyright 2022 INRAE, French National Research Institute for Agriculture, Food and Environment
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// std
+#include <memory>
+#include <thread>
+#include <vector>
+
+// gtest
+#include "gtest/gtest.h"
+
+// romea
+#include "romea_localisation_utils/filter/triple_buffer.hpp"
+
+namespace
+{
+
+struct FakeResults
+{
+  explicit FakeResults(size_t size)
+  : values(size, 0)
+  {
+  }
+
+  std::vector<size_t> values;
+};
+
+std::unique_ptr<romea::ros2::TripleBuffer<FakeResults>> make_buffer(size_t size)
+{
+  return std::make_unique<romea::ros2::TripleBuffer<FakeResults>>(
+    std::make_unique<FakeResults>(size),
+    std::make_unique<FakeResults>(size),
+    std::make_unique<FakeResults>(size));
+}
+
+}  // namespace
+
+//-----------------------------------------------------------------------------
+TEST(TestTripleBuffer, readLatestPublication)
+{
+  auto buffer = make_buffer(4);
+  EXPECT_FALSE(buffer->has_new_data());
+
+  buffer->write_buffer().values[0] = 1;
+  buffer->publish();
+  buffer->write_buffer().values[0] = 2;
+  buffer->publish();
+
+  EXPECT_TRUE(buffer->has_new_data());
+  EXPECT_EQ(buffer->read().values[0], 2u);
+  EXPECT_FALSE(buffer->has_new_data());
+  EXPECT_EQ(buffer->read().values[0], 2u);
+  EXPECT_EQ(buffer->number_of_publications(), 2u);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestTripleBuffer, throwWithNullBuffer)
+{
+  EXPECT_THROW(
+    romea::ros2::TripleBuffer<FakeResults>(
+      std::make_unique<FakeResults>(1), nullptr, std::make_unique<FakeResults>(1)),
+    std::runtime_error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(TestTripleBuffer, concurrentReadsAreConsistent)
+{
+  const size_t size = 64;
+  const size_t number_of_publications = 20000;
+  auto buffer = make_buffer(size);
+
+  std::thread producer([&]() {
+      for (size_t n = 1; n <= number_of_publications; ++n) {
+        auto & results = buffer->write_buffer();
+        for (auto & value : results.values) {
+          value = n;
+        }
+        buffer->publish();
+      }
+    });
+
+  size_t last = 0;
+  while (last != number_of_publications) {
+    const auto & results = buffer->read();
+    for (const auto & value : results.values) {
+      ASSERT_EQ(value, results.values[0]);
+    }
+    ASSERT_GE(results.values[0], last);
+    last = results.values[0];
+  }
+
+  producer.join();
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
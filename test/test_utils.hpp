@@ -15,6 +15,18 @@
 #ifndef TEST_UTILS_HPP_
 #define TEST_UTILS_HPP_
 
+// std
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// romea
+#include "romea_core_common/diagnostic/DiagnosticReport.hpp"
+#include "romea_core_common/time/Time.hpp"
 
 //-----------------------------------------------------------------------------
 template<typename MsgCovType>
@@ -65,5 +77,148 @@ void isSame(
   }
 }
 
+//-----------------------------------------------------------------------------
+inline romea::core::Duration ms(const long & milliseconds)
+{
+  return std::chrono::milliseconds(milliseconds);
+}
+
+// update applied by a fake updater, step is the number of filter steps run so
+// far when filter is given to updater
+struct Event
+{
+  std::string updater;
+  romea::core::Duration stamp;
+  size_t step;
+  double value;
+};
+
+// updates can be applied from a runtime thread while test reads them
+class EventLog
+{
+public:
+  void push_back(const Event & event)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(event);
+  }
+
+  Event operator[](const size_t & index) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.at(index);
+  }
+
+  std::vector<Event> get() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+  }
+
+  size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+};
+
+// filter fake applying updates immediately or once run_deferred is called, like
+// a filter replaying kept update functions, each process call is one step
+struct FakeFilter
+{
+  template<typename UpdateFunction>
+  void process(const romea::core::Duration & duration, UpdateFunction && update)
+  {
+    auto run = [this, duration, update = std::forward<UpdateFunction>(update)]() mutable {
+        int state = 0;
+        int info = 0;
+        ++number_of_steps;
+        update(duration, state, info);
+      };
+
+    if (is_deferred) {
+      deferred.push_back(std::move(run));
+    } else {
+      run();
+    }
+  }
+
+  void run_deferred()
+  {
+    for (auto & run : deferred) {
+      run();
+    }
+    deferred.clear();
+  }
+
+  size_t number_of_steps = 0;
+  bool is_deferred = false;
+  std::vector<std::function<void()>> deferred;
+};
+
+// value recorded by fake updaters, specialise it to check observation contents
+template<typename Observation>
+double fake_observation_value(const Observation & /*observation*/)
+{
+  return 0;
+}
+
+template<typename Observation_>
+struct FakeUpdater
+{
+  using Observation = Observation_;
+
+  FakeUpdater(
+    const std::string & name,
+    EventLog & events,
+    std::shared_ptr<FakeFilter> filter = nullptr)
+  : name(name),
+    events(events),
+    filter(filter)
+  {
+  }
+
+  void update(
+    const romea::core::Duration & duration,
+    const Observation & observation,
+    int & /*state*/,
+    int & /*info*/)
+  {
+    size_t step = filter ? filter->number_of_steps : 0;
+    events.push_back({name, duration, step, fake_observation_value(observation)});
+  }
+
+  bool heartBeatCallback(const romea::core::Duration & /*duration*/)
+  {
+    return is_alive;
+  }
+
+  romea::core::DiagnosticReport getReport()
+  {
+    romea::core::DiagnosticReport report;
+    report.info["fake"] = "1";
+    return report;
+  }
+
+  std::string name;
+  EventLog & events;
+  std::shared_ptr<FakeFilter> filter;
+  bool is_alive = true;
+};
 
 #endif  // TEST_UTILS_HPP_